@@ -407,7 +407,8 @@ GPU_Rect NFont::Rectf::to_GPU_Rect() const
 
 
 
-char* NFont::buffer = NULL;  // Shared buffer for efficient drawing
+// Formatting buffer, one per thread so text can be measured off the render thread
+static thread_local char buffer[NFONT_BUFFER_SIZE];
 
 
 // Constructors
@@ -494,9 +495,6 @@ NFont& NFont::operator=(const NFont& font)
 void NFont::init()
 {
     font = FC_CreateFont();
-
-    if(buffer == NULL)
-        buffer = new char[NFONT_BUFFER_SIZE];
 }
 
 
@@ -592,6 +590,16 @@ void NFont::free()
     FC_ClearFont(font);
 }
 
+bool NFont::saveGlyphCache(SDL_RWops* dst, const char* source)
+{
+    return FC_SaveGlyphCache(font, dst, source);
+}
+
+bool NFont::loadGlyphCache(SDL_RWops* src, const char* source)
+{
+    return FC_LoadGlyphCache(font, src, source);
+}
+
 
 
 NFont::Rectf NFont::draw(NFont_Target* dest, float x, float y, const char* formatted_text, ...)
@@ -662,9 +670,9 @@ NFont::Rectf NFont::drawBox(NFont_Target* dest, const Rectf& box, const char* fo
     va_end(lst);
 
     #ifdef NFONT_USE_SDL_GPU
-    return FC_DrawBox(font, dest, box.to_GPU_Rect(), "%s", buffer);
+    return FC_DrawBoxText(font, dest, box.to_GPU_Rect(), FC_MakeEffect(FC_ALIGN_LEFT, FC_MakeScale(1,1), FC_GetDefaultColor(font)), buffer);
     #else
-    return FC_DrawBox(font, dest, box.to_SDL_Rect(), "%s", buffer);
+    return FC_DrawBoxText(font, dest, box.to_SDL_Rect(), FC_MakeEffect(FC_ALIGN_LEFT, FC_MakeScale(1,1), FC_GetDefaultColor(font)), buffer);
     #endif
 }
 
@@ -728,9 +736,9 @@ NFont::Rectf NFont::drawBox(NFont_Target* dest, const Rectf& box, const Color& c
     va_end(lst);
 
     #ifdef NFONT_USE_SDL_GPU
-    return FC_DrawBoxColor(font, dest, box.to_GPU_Rect(), color.to_SDL_Color(), "%s", buffer);
+    return FC_DrawBoxText(font, dest, box.to_GPU_Rect(), FC_MakeEffect(FC_ALIGN_LEFT, FC_MakeScale(1,1), color.to_SDL_Color()), buffer);
     #else
-    return FC_DrawBoxColor(font, dest, box.to_SDL_Rect(), color.to_SDL_Color(), "%s", buffer);
+    return FC_DrawBoxText(font, dest, box.to_SDL_Rect(), FC_MakeEffect(FC_ALIGN_LEFT, FC_MakeScale(1,1), color.to_SDL_Color()), buffer);
     #endif
 }
 
@@ -745,9 +753,42 @@ NFont::Rectf NFont::drawBox(NFont_Target* dest, const Rectf& box, const Effect&
     va_end(lst);
 
     #ifdef NFONT_USE_SDL_GPU
-    return FC_DrawBoxEffect(font, dest, box.to_GPU_Rect(), FC_MakeEffect(translate_enum_NFont_to_FC(effect.alignment), FC_MakeScale(effect.scale.x, effect.scale.y), effect.color.to_SDL_Color()), "%s", buffer);
+    return FC_DrawBoxText(font, dest, box.to_GPU_Rect(), FC_MakeEffect(translate_enum_NFont_to_FC(effect.alignment), FC_MakeScale(effect.scale.x, effect.scale.y), effect.color.to_SDL_Color()), buffer);
+    #else
+    return FC_DrawBoxText(font, dest, box.to_SDL_Rect(), FC_MakeEffect(translate_enum_NFont_to_FC(effect.alignment), FC_MakeScale(effect.scale.x, effect.scale.y), effect.color.to_SDL_Color()), buffer);
+    #endif
+}
+
+NFont::Rectf NFont::draw(NFont_Target* dest, float x, float y, const std::string& text)
+{
+    return FC_DrawText(font, dest, x, y, FC_MakeEffect(FC_ALIGN_LEFT, FC_MakeScale(1,1), FC_GetDefaultColor(font)), text.c_str());
+}
+
+NFont::Rectf NFont::draw(NFont_Target* dest, float x, float y, const Effect& effect, const std::string& text)
+{
+    return FC_DrawText(font, dest, x, y, FC_MakeEffect(translate_enum_NFont_to_FC(effect.alignment), FC_MakeScale(effect.scale.x, effect.scale.y), effect.color.to_SDL_Color()), text.c_str());
+}
+
+NFont::Rectf NFont::drawBox(NFont_Target* dest, const Rectf& box, const std::string& text)
+{
+    return drawBox(dest, box, Color(FC_GetDefaultColor(font)), text);
+}
+
+NFont::Rectf NFont::drawBox(NFont_Target* dest, const Rectf& box, const Color& color, const std::string& text)
+{
+    #ifdef NFONT_USE_SDL_GPU
+    return FC_DrawBoxText(font, dest, box.to_GPU_Rect(), FC_MakeEffect(FC_ALIGN_LEFT, FC_MakeScale(1,1), color.to_SDL_Color()), text.c_str());
     #else
-    return FC_DrawBoxEffect(font, dest, box.to_SDL_Rect(), FC_MakeEffect(translate_enum_NFont_to_FC(effect.alignment), FC_MakeScale(effect.scale.x, effect.scale.y), effect.color.to_SDL_Color()), "%s", buffer);
+    return FC_DrawBoxText(font, dest, box.to_SDL_Rect(), FC_MakeEffect(FC_ALIGN_LEFT, FC_MakeScale(1,1), color.to_SDL_Color()), text.c_str());
+    #endif
+}
+
+NFont::Rectf NFont::drawBox(NFont_Target* dest, const Rectf& box, const Effect& effect, const std::string& text)
+{
+    #ifdef NFONT_USE_SDL_GPU
+    return FC_DrawBoxText(font, dest, box.to_GPU_Rect(), FC_MakeEffect(translate_enum_NFont_to_FC(effect.alignment), FC_MakeScale(effect.scale.x, effect.scale.y), effect.color.to_SDL_Color()), text.c_str());
+    #else
+    return FC_DrawBoxText(font, dest, box.to_SDL_Rect(), FC_MakeEffect(translate_enum_NFont_to_FC(effect.alignment), FC_MakeScale(effect.scale.x, effect.scale.y), effect.color.to_SDL_Color()), text.c_str());
     #endif
 }
 
@@ -917,7 +958,12 @@ Uint16 NFont::getWidth(const char* formatted_text, ...)
     vsnprintf(buffer, NFONT_BUFFER_SIZE, formatted_text, lst);
     va_end(lst);
 
-    return FC_GetWidth(font, "%s", buffer);
+    return FC_GetTextWidth(font, buffer);
+}
+
+Uint16 NFont::getWidth(const std::string& text)
+{
+    return FC_GetTextWidth(font, text.c_str());
 }
 
 
@@ -959,7 +1005,12 @@ Uint16 NFont::getColumnHeight(Uint16 width, const char* formatted_text, ...)
     vsnprintf(buffer, NFONT_BUFFER_SIZE, formatted_text, lst);
     va_end(lst);
 
-    return FC_GetColumnHeight(font, width, "%s", buffer);
+    return FC_GetTextColumnHeight(font, width, buffer);
+}
+
+Uint16 NFont::getColumnHeight(Uint16 width, const std::string& text)
+{
+    return FC_GetTextColumnHeight(font, width, text.c_str());
 }
 
 int NFont::getAscent(const char character)
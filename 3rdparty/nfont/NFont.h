@@ -54,6 +54,7 @@ THE SOFTWARE.
 #endif 
 
 #include "stdarg.h"
+#include <string>
 
 // Let's pretend this exists...
 #ifndef TTF_STYLE_OUTLINE
@@ -234,6 +235,9 @@ class NFONT_EXPORT NFont
     
     void free();
 
+    bool saveGlyphCache(SDL_RWops* dst, const char* source);
+    bool loadGlyphCache(SDL_RWops* src, const char* source);
+
     // Drawing
     #ifdef NFONT_USE_SDL_GPU
     Rectf draw(GPU_Target* dest, float x, float y, const char* formatted_text, ...) NFONT_FORMAT(5);
@@ -253,6 +257,13 @@ class NFONT_EXPORT NFont
     Rectf drawColumn(GPU_Target* dest, float x, float y, Uint16 width, const Scale& scale, const char* formatted_text, ...) NFONT_FORMAT(7);
     Rectf drawColumn(GPU_Target* dest, float x, float y, Uint16 width, const Color& color, const char* formatted_text, ...) NFONT_FORMAT(7);
     Rectf drawColumn(GPU_Target* dest, float x, float y, Uint16 width, const Effect& effect, const char* formatted_text, ...) NFONT_FORMAT(7);
+    
+    // Unformatted text, laid out straight from the string without a printf pass
+    Rectf draw(GPU_Target* dest, float x, float y, const std::string& text);
+    Rectf draw(GPU_Target* dest, float x, float y, const Effect& effect, const std::string& text);
+    Rectf drawBox(GPU_Target* dest, const Rectf& box, const std::string& text);
+    Rectf drawBox(GPU_Target* dest, const Rectf& box, const Color& color, const std::string& text);
+    Rectf drawBox(GPU_Target* dest, const Rectf& box, const Effect& effect, const std::string& text);
     #else
     Rectf draw(SDL_Renderer* dest, float x, float y, const char* formatted_text, ...) NFONT_FORMAT(5);
     Rectf draw(SDL_Renderer* dest, float x, float y, AlignEnum align, const char* formatted_text, ...) NFONT_FORMAT(6);
@@ -271,6 +282,13 @@ class NFONT_EXPORT NFont
     Rectf drawColumn(SDL_Renderer* dest, float x, float y, Uint16 width, const Scale& scale, const char* formatted_text, ...) NFONT_FORMAT(7);
     Rectf drawColumn(SDL_Renderer* dest, float x, float y, Uint16 width, const Color& color, const char* formatted_text, ...) NFONT_FORMAT(7);
     Rectf drawColumn(SDL_Renderer* dest, float x, float y, Uint16 width, const Effect& effect, const char* formatted_text, ...) NFONT_FORMAT(7);
+    
+    // Unformatted text, laid out straight from the string without a printf pass
+    Rectf draw(SDL_Renderer* dest, float x, float y, const std::string& text);
+    Rectf draw(SDL_Renderer* dest, float x, float y, const Effect& effect, const std::string& text);
+    Rectf drawBox(SDL_Renderer* dest, const Rectf& box, const std::string& text);
+    Rectf drawBox(SDL_Renderer* dest, const Rectf& box, const Color& color, const std::string& text);
+    Rectf drawBox(SDL_Renderer* dest, const Rectf& box, const Effect& effect, const std::string& text);
     #endif
     
     // Getters
@@ -278,9 +296,11 @@ class NFONT_EXPORT NFont
     Uint16 getHeight() const;
     Uint16 getHeight(const char* formatted_text, ...) const NFONT_FORMAT(2);
     Uint16 getWidth(const char* formatted_text, ...) NFONT_FORMAT(2);
+    Uint16 getWidth(const std::string& text);
     Rectf getCharacterOffset(Uint16 position_index, int column_width, const char* formatted_text, ...) NFONT_FORMAT(4);
     Uint16 getPositionFromOffset(float x, float y, int column_width, NFont::AlignEnum align, const char* formatted_text, ...) NFONT_FORMAT(6);
     Uint16 getColumnHeight(Uint16 width, const char* formatted_text, ...) NFONT_FORMAT(3);
+    Uint16 getColumnHeight(Uint16 width, const std::string& text);
     int getSpacing() const;
     int getLineSpacing() const;
     Uint16 getBaseline() const;
@@ -308,7 +328,6 @@ class NFONT_EXPORT NFont
     
   private:
     
-    static char* buffer;
     FC_Font* font;
     
     void init();  // Common constructor
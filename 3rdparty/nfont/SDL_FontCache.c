@@ -31,6 +31,32 @@ See SDL_FontCache.h for license info.
     #define ENABLE_SDL_CLIPPING
 #endif
 
+// Runs of ASCII are measured 16 or 32 bytes at a time with whichever of these the CPU has
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define FC_USE_SSE2
+#endif
+
+#if SDL_VERSION_ATLEAST(2,0,4) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define FC_USE_AVX2
+    #define FC_TARGET_AVX2 __attribute__((target("avx2")))
+#elif SDL_VERSION_ATLEAST(2,0,4) && defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <immintrin.h>
+    #define FC_USE_AVX2
+    #define FC_TARGET_AVX2
+#endif
+
+#if SDL_VERSION_ATLEAST(2,0,6) && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+    #include <arm_neon.h>
+    #define FC_USE_NEON
+#endif
+
+// Need SDL_RenderGeometry() to submit a whole string per glyph cache texture
+#if !defined(FC_USE_SDL_GPU) && SDL_VERSION_ATLEAST(2,0,18)
+    #define FC_USE_GLYPH_BATCHING
+#endif
+
 #define FC_MIN(a,b) ((a) < (b)? (a) : (b))
 #define FC_MAX(a,b) ((a) > (b)? (a) : (b))
 
@@ -80,6 +106,10 @@ __inline int c99_snprintf(char *outBuf, size_t size, const char *format, ...)
 // Extra pixels of padding around each glyph to avoid linear filtering artifacts
 #define FC_CACHE_PADDING 1
 
+// Bytes of wrapped text kept per font before the least recently used layouts are dropped
+#define FC_DEFAULT_LAYOUT_CACHE_BUDGET (64*1024)
+#define FC_DEFAULT_BATCH_CAPACITY 64
+
 
 
 static Uint8 has_clip(FC_Target* dest)
@@ -144,22 +174,34 @@ static char* new_concat(const char* a, const char* b)
     return new_string;
 }
 
-static char* replace_concat(char** a, const char* b)
-{
-    char* new_string = new_concat(*a, b);
-    free(*a);
-    *a = new_string;
-    return *a;
-}
 
 
 
 
+// A wrapped line as a span of the source text, so wrapping never copies it
+typedef struct FC_LineBreak
+{
+    int start;
+    int length;
+    Uint8 space;  // Wrapped lines end in a space even where the source text has none
+} FC_LineBreak;
+
+// Scratch space for variadic text and line breaks, one per thread so fonts can be measured and laid out off the render thread
+typedef struct FC_Buffer
+{
+    char* data;
+    unsigned int size;
+
+    FC_LineBreak* lines;
+    int lines_capacity;
+} FC_Buffer;
 
-// Shared buffer for variadic text
-static char* fc_buffer = NULL;
+static SDL_TLSID fc_buffer_id = 0;
 static unsigned int fc_buffer_size = 1024;
 
+static SDL_SpinLock fc_global_lock = 0;
+static SDL_atomic_t fc_global_ready;
+
 static Uint8 fc_has_render_target_support = 0;
 
 const char* FC_GetStringASCII(void)
@@ -273,143 +315,366 @@ FC_GlyphData FC_MakeGlyphData(int cache_level, Sint16 x, Sint16 y, Uint16 w, Uin
     return gd;
 }
 
-// Enough to hold all of the ascii characters and some.
-#define FC_DEFAULT_NUM_BUCKETS 300
+// Codepoints below this are looked up directly instead of hashed
+#define FC_MAP_ASCII_SIZE 128
+
+// Starting slot count for the other codepoints, always a power of two
+#define FC_DEFAULT_MAP_CAPACITY 64
 
-typedef struct FC_MapNode
+// Never a valid codepoint, so it marks free slots
+#define FC_MAP_EMPTY_KEY 0xFFFFFFFF
+// ASCII width of a glyph that isn't there yet (or is too wide for the table)
+#define FC_MAP_NO_WIDTH 0xFFFF
+
+typedef struct FC_MapEntry
 {
     Uint32 key;
     FC_GlyphData value;
-    struct FC_MapNode* next;
-
-} FC_MapNode;
+} FC_MapEntry;
 
+// ASCII glyphs sit in a flat array, the rest in an open-addressing table with linear probing
 typedef struct FC_Map
 {
-    int num_buckets;
-    FC_MapNode** buckets;
+    FC_GlyphData ascii[FC_MAP_ASCII_SIZE];  // cache_level is -1 for missing glyphs
+    Uint16 ascii_widths[FC_MAP_ASCII_SIZE + 1];  // Same glyphs packed tight for measuring, plus a zero so 32-bit gathers of the last one stay inside
+    int count;
+    int hashed;  // Entries in the table, which the load factor counts rather than count
+    int capacity;
+    FC_MapEntry* entries;
 } FC_Map;
 
+// A glyph placed by a layout, x is from the start of its line at scale 1
+typedef struct FC_LayoutGlyph
+{
+    float x;
+    FC_GlyphData data;
+} FC_LayoutGlyph;
+
+typedef struct FC_LayoutLine
+{
+    int first_glyph;
+    int num_glyphs;
+    Uint16 width;  // What FC_GetTextWidth() gives for the line, for centering and right alignment
+} FC_LayoutLine;
+
+// Text wrapped to a column width and placed glyph by glyph, kept so the same box isn't laid out again every frame
+typedef struct FC_Layout
+{
+    Uint32 hash;
+    int width;
+    char* text;
+    FC_LayoutLine* lines;
+    int num_lines;
+    FC_LayoutGlyph* glyphs;  // Spaces only move the pen, so they aren't kept
+    int height;
+    unsigned int size;
+
+    struct FC_Layout* prev;
+    struct FC_Layout* next;
+} FC_Layout;
+
+#ifdef FC_USE_GLYPH_BATCHING
+// Glyph quads waiting to go out in a single SDL_RenderGeometry() call
+typedef struct FC_GlyphBatch
+{
+    SDL_Vertex* vertices;  // Texture coordinates stay in pixels until the flush
+    int* indices;
+    int num_quads;
+    int capacity;  // In quads
+} FC_GlyphBatch;
+#endif
+
 
 
-static FC_Map* FC_MapCreate(int num_buckets)
+static void FC_MapAllocEntries(FC_Map* map, int capacity)
 {
     int i;
-    FC_Map* map = (FC_Map*)malloc(sizeof(FC_Map));
 
-    map->num_buckets = num_buckets;
-    map->buckets = (FC_MapNode**)malloc(num_buckets * sizeof(FC_MapNode*));
+    map->capacity = capacity;
+    map->entries = (FC_MapEntry*)malloc(capacity * sizeof(FC_MapEntry));
+    for(i = 0; i < capacity; ++i)
+        map->entries[i].key = FC_MAP_EMPTY_KEY;
+}
+
+static FC_Map* FC_MapCreate(int capacity)
+{
+    int i;
+    FC_Map* map = (FC_Map*)malloc(sizeof(FC_Map));
 
-    for(i = 0; i < num_buckets; ++i)
+    for(i = 0; i < FC_MAP_ASCII_SIZE; ++i)
     {
-        map->buckets[i] = NULL;
+        map->ascii[i].cache_level = -1;
+        map->ascii_widths[i] = FC_MAP_NO_WIDTH;
     }
+    map->ascii_widths[FC_MAP_ASCII_SIZE] = 0;
+    map->count = 0;
+    map->hashed = 0;
+    FC_MapAllocEntries(map, capacity);
 
     return map;
 }
 
-/*static void FC_MapClear(FC_Map* map)
+static void FC_MapFree(FC_Map* map)
 {
-    int i;
     if(map == NULL)
         return;
 
-    // Go through each bucket
-    for(i = 0; i < map->num_buckets; ++i)
-    {
-        // Delete the nodes in order
-        FC_MapNode* node = map->buckets[i];
-        while(node != NULL)
-        {
-            FC_MapNode* last = node;
-            node = node->next;
-            free(last);
-        }
-        // Set the bucket to empty
-        map->buckets[i] = NULL;
-    }
-}*/
+    free(map->entries);
+    free(map);
+}
 
-static void FC_MapFree(FC_Map* map)
+static_inline Uint32 FC_MapSlot(FC_Map* map, Uint32 codepoint)
+{
+    // Fibonacci hashing spreads neighbouring codepoints over the table
+    return (codepoint * 2654435769u) & (map->capacity - 1);
+}
+
+static FC_MapEntry* FC_MapProbe(FC_Map* map, Uint32 codepoint)
+{
+    Uint32 index = FC_MapSlot(map, codepoint);
+
+    // The table is never more than half full, so this always reaches a match or a free slot
+    while(map->entries[index].key != codepoint && map->entries[index].key != FC_MAP_EMPTY_KEY)
+        index = (index + 1) & (map->capacity - 1);
+
+    return &map->entries[index];
+}
+
+static void FC_MapGrow(FC_Map* map)
 {
     int i;
-    if(map == NULL)
-        return;
+    int old_capacity = map->capacity;
+    FC_MapEntry* old_entries = map->entries;
 
-    // Go through each bucket
-    for(i = 0; i < map->num_buckets; ++i)
+    FC_MapAllocEntries(map, old_capacity * 2);
+    for(i = 0; i < old_capacity; ++i)
     {
-        // Delete the nodes in order
-        FC_MapNode* node = map->buckets[i];
-        while(node != NULL)
-        {
-            FC_MapNode* last = node;
-            node = node->next;
-            free(last);
-        }
+        if(old_entries[i].key != FC_MAP_EMPTY_KEY)
+            *FC_MapProbe(map, old_entries[i].key) = old_entries[i];
     }
 
-    free(map->buckets);
-    free(map);
+    free(old_entries);
 }
 
-// Note: Does not handle duplicates in any special way.
+// Replaces the glyph if the codepoint is already present.  The returned pointer is valid until the next insert.
 static FC_GlyphData* FC_MapInsert(FC_Map* map, Uint32 codepoint, FC_GlyphData glyph)
 {
-    Uint32 index;
-    FC_MapNode* node;
-    if(map == NULL)
+    FC_MapEntry* entry;
+    if(map == NULL || codepoint == FC_MAP_EMPTY_KEY)
         return NULL;
 
-    // Get index for bucket
-    index = codepoint % map->num_buckets;
-
-    // If this bucket is empty, create a node and return its value
-    if(map->buckets[index] == NULL)
+    if(codepoint < FC_MAP_ASCII_SIZE)
     {
-        node = map->buckets[index] = (FC_MapNode*)malloc(sizeof(FC_MapNode));
-        node->key = codepoint;
-        node->value = glyph;
-        node->next = NULL;
-        return &node->value;
+        if(map->ascii[codepoint].cache_level < 0)
+            map->count++;
+        map->ascii[codepoint] = glyph;
+        map->ascii_widths[codepoint] = (glyph.rect.w < 0x8000? glyph.rect.w : FC_MAP_NO_WIDTH);
+        return &map->ascii[codepoint];
     }
 
-    for(node = map->buckets[index]; node != NULL; node = node->next)
-    {
-        // Find empty node and add a new one on.
-        if(node->next == NULL)
-        {
-            node->next = (FC_MapNode*)malloc(sizeof(FC_MapNode));
-            node = node->next;
+    if(2*(map->hashed + 1) > map->capacity)
+        FC_MapGrow(map);
 
-            node->key = codepoint;
-            node->value = glyph;
-            node->next = NULL;
-            return &node->value;
-        }
+    entry = FC_MapProbe(map, codepoint);
+    if(entry->key == FC_MAP_EMPTY_KEY)
+    {
+        entry->key = codepoint;
+        map->count++;
+        map->hashed++;
     }
+    entry->value = glyph;
 
-    return NULL;
+    return &entry->value;
 }
 
 static FC_GlyphData* FC_MapFind(FC_Map* map, Uint32 codepoint)
 {
-    Uint32 index;
-    FC_MapNode* node;
+    FC_MapEntry* entry;
     if(map == NULL)
         return NULL;
 
-    // Get index for bucket
-    index = codepoint % map->num_buckets;
+    if(codepoint < FC_MAP_ASCII_SIZE)
+        return (map->ascii[codepoint].cache_level < 0? NULL : &map->ascii[codepoint]);
+
+    entry = FC_MapProbe(map, codepoint);
+    return (entry->key == codepoint? &entry->value : NULL);
+}
+
+// Copies every stored codepoint into result, ASCII first
+static void FC_MapGetKeys(FC_Map* map, Uint32* result)
+{
+    Uint32 i;
+    unsigned int count = 0;
+
+    for(i = 0; i < FC_MAP_ASCII_SIZE; ++i)
+    {
+        if(map->ascii[i].cache_level >= 0)
+            result[count++] = i;
+    }
+
+    for(i = 0; i < (Uint32)map->capacity; ++i)
+    {
+        if(map->entries[i].key != FC_MAP_EMPTY_KEY)
+            result[count++] = map->entries[i].key;
+    }
+}
+
+
+
+// Each adds up the widths of plain ASCII from the start of text and returns the bytes used.
+// They stop at a newline, a multi-byte sequence or a glyph that isn't in the width table yet.
+static int FC_MeasureASCII_Scalar(const Uint16* widths, const char* text, int length, Uint32* width)
+{
+    int done;
+    for(done = 0; done < length; ++done)
+    {
+        Uint8 c = (Uint8)text[done];
+        if(c >= 0x80 || c == '\n' || widths[c] == FC_MAP_NO_WIDTH)
+            break;
+        *width += widths[c];
+    }
+    return done;
+}
+
+#if defined(FC_USE_SSE2) || defined(FC_USE_NEON)
+// Sums a block the vector compare already found to be plain ASCII, leaving width alone if any glyph is missing
+static_inline Uint8 FC_SumASCIIWidths(const Uint16* widths, const char* text, int count, Uint32* width)
+{
+    Uint32 total = 0;
+    Uint16 missing = 0;
+    int i;
+    for(i = 0; i < count; ++i)
+    {
+        Uint16 w = widths[(Uint8)text[i]];
+        total += w;
+        missing |= w;
+    }
+
+    // FC_MAP_NO_WIDTH is the only entry with the high bit set
+    if(missing & 0x8000)
+        return 0;
+
+    *width += total;
+    return 1;
+}
+#endif
+
+#ifdef FC_USE_SSE2
+static int FC_MeasureASCII_SSE2(const Uint16* widths, const char* text, int length, Uint32* width)
+{
+    const __m128i newline = _mm_set1_epi8('\n');
+    int done = 0;
+
+    while(length - done >= 16)
+    {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(text + done));
+        // Multi-byte UTF-8 has the high bit set and newlines compare to all ones, so either shows in the mask
+        if(_mm_movemask_epi8(_mm_or_si128(bytes, _mm_cmpeq_epi8(bytes, newline))) != 0)
+            break;
+        if(!FC_SumASCIIWidths(widths, text + done, 16, width))
+            break;
+        done += 16;
+    }
+
+    return done + FC_MeasureASCII_Scalar(widths, text + done, length - done, width);
+}
+#endif
+
+#ifdef FC_USE_AVX2
+FC_TARGET_AVX2 static int FC_MeasureASCII_AVX2(const Uint16* widths, const char* text, int length, Uint32* width)
+{
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i low_half = _mm256_set1_epi32(0xFFFF);
+    const __m256i no_width = _mm256_set1_epi32(0x8000);
+    __m256i sum = _mm256_setzero_si256();
+    __m128i total;
+    int done = 0;
+    int i;
+
+    while(length - done >= 32)
+    {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)(text + done));
+        __m256i block = _mm256_setzero_si256();
+        __m256i missing = _mm256_setzero_si256();
+        if(_mm256_movemask_epi8(_mm256_or_si256(bytes, _mm256_cmpeq_epi8(bytes, newline))) != 0)
+            break;
+
+        // Widths come out of the table eight at a time; each gather reads 32 bits, so the next entry is masked off
+        for(i = 0; i < 32; i += 8)
+        {
+            __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(text + done + i)));
+            __m256i w = _mm256_and_si256(_mm256_i32gather_epi32((const int*)widths, index, 2), low_half);
+            block = _mm256_add_epi32(block, w);
+            missing = _mm256_or_si256(missing, w);
+        }
+        if(!_mm256_testz_si256(missing, no_width))
+            break;
+
+        sum = _mm256_add_epi32(sum, block);
+        done += 32;
+    }
+
+    total = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(1, 0, 3, 2)));
+    total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(2, 3, 0, 1)));
+    *width += (Uint32)_mm_cvtsi128_si32(total);
 
-    // Go through list until we find a match
-    for(node = map->buckets[index]; node != NULL; node = node->next)
+    return done + FC_MeasureASCII_Scalar(widths, text + done, length - done, width);
+}
+#endif
+
+#ifdef FC_USE_NEON
+static int FC_MeasureASCII_NEON(const Uint16* widths, const char* text, int length, Uint32* width)
+{
+    const uint8x16_t newline = vdupq_n_u8('\n');
+    int done = 0;
+
+    while(length - done >= 16)
     {
-        if(node->key == codepoint)
-            return &node->value;
+        uint8x16_t bytes = vld1q_u8((const uint8_t*)(text + done));
+        uint64x2_t flags = vreinterpretq_u64_u8(vorrq_u8(vshrq_n_u8(bytes, 7), vceqq_u8(bytes, newline)));
+        if((vgetq_lane_u64(flags, 0) | vgetq_lane_u64(flags, 1)) != 0)
+            break;
+        if(!FC_SumASCIIWidths(widths, text + done, 16, width))
+            break;
+        done += 16;
     }
 
-    return NULL;
+    return done + FC_MeasureASCII_Scalar(widths, text + done, length - done, width);
+}
+#endif
+
+typedef struct FC_ASCIIMeasurer
+{
+    const char* name;
+    int (*measure)(const Uint16* widths, const char* text, int length, Uint32* width);
+    SDL_bool (*supported)(void);  // NULL when every CPU can run it
+} FC_ASCIIMeasurer;
+
+// Slowest first, the last one the CPU supports gets used
+static const FC_ASCIIMeasurer fc_ascii_measurers[] = {
+    {"scalar", &FC_MeasureASCII_Scalar, NULL},
+    #ifdef FC_USE_SSE2
+    {"sse2", &FC_MeasureASCII_SSE2, &SDL_HasSSE2},
+    #endif
+    #ifdef FC_USE_AVX2
+    {"avx2", &FC_MeasureASCII_AVX2, &SDL_HasAVX2},
+    #endif
+    #ifdef FC_USE_NEON
+    {"neon", &FC_MeasureASCII_NEON, &SDL_HasNEON},
+    #endif
+};
+
+static const FC_ASCIIMeasurer* fc_ascii_measurer = &fc_ascii_measurers[0];
+
+static void FC_SelectMeasureASCII(void)
+{
+    int i;
+    for(i = 0; i < (int)(sizeof(fc_ascii_measurers)/sizeof(fc_ascii_measurers[0])); ++i)
+    {
+        if(fc_ascii_measurers[i].supported == NULL || fc_ascii_measurers[i].supported())
+            fc_ascii_measurer = &fc_ascii_measurers[i];
+    }
 }
 
 
@@ -447,9 +712,35 @@ struct FC_Font
 
     char* loading_string;
 
+    // Guards the glyph map and layouts against worker threads.  SDL mutexes are recursive,
+    // so locked entry points like FC_DrawColumnFromText() may call others like FC_RenderLeft().
+    SDL_mutex* mutex;
+    SDL_threadID render_thread;
+    unsigned int deferred_glyphs;  // Lookups that fell back because only the render thread may rasterize
+
+    FC_Layout* layouts;  // Most recently used first
+    FC_Layout* last_layout;
+    FC_Layout** layout_index;  // Open-addressing table over the same layouts, keyed by hash and width
+    FC_Layout* unresolved_layout;  // Last layout measured with deferred glyphs, kept out of the cache
+    int layout_index_count;
+    int layout_index_capacity;
+    unsigned int layout_cache_size;
+    unsigned int layout_cache_budget;
+
+    #ifdef FC_USE_GLYPH_BATCHING
+    FC_GlyphBatch* batches;  // One per glyph cache level
+    int num_batches;
+    int batch_depth;
+    Uint8 batching;
+    SDL_Color draw_color;  // Baked into the batched vertices
+    #endif
+
 };
 
 // Private
+static void FC_ClearLayoutCache(FC_Font* font);
+static void FC_FreeBatches(FC_Font* font);
+static Uint8 FC_FindGlyphData(FC_Font* font, FC_GlyphData* result, Uint32 codepoint);
 static FC_GlyphData* FC_PackGlyphData(FC_Font* font, Uint32 codepoint, Uint16 width, Uint16 maxWidth, Uint16 maxHeight);
 
 
@@ -817,14 +1108,67 @@ unsigned int FC_GetBufferSize(void)
 
 void FC_SetBufferSize(unsigned int size)
 {
-    free(fc_buffer);
+    // Each thread's buffer picks up the new size the next time it is used
     if(size > 0)
-    {
         fc_buffer_size = size;
-        fc_buffer = (char*)malloc(fc_buffer_size);
+}
+
+static void FC_FreeBuffer(void* data)
+{
+    FC_Buffer* buffer = (FC_Buffer*)data;
+    free(buffer->data);
+    free(buffer->lines);
+    free(buffer);
+}
+
+// Sets up the state shared by every font exactly once, whichever thread gets here first
+static void FC_InitGlobals(void)
+{
+    if(SDL_AtomicGet(&fc_global_ready))
+        return;
+
+    SDL_AtomicLock(&fc_global_lock);
+    if(!SDL_AtomicGet(&fc_global_ready))
+    {
+        fc_buffer_id = SDL_TLSCreate();
+        FC_GetStringASCII_Latin1();
+        FC_SelectMeasureASCII();
+        SDL_AtomicSet(&fc_global_ready, 1);
     }
-    else
-        fc_buffer = (char*)malloc(fc_buffer_size);
+    SDL_AtomicUnlock(&fc_global_lock);
+}
+
+static FC_Buffer* FC_GetThreadBuffer(void)
+{
+    FC_Buffer* buffer;
+
+    FC_InitGlobals();
+    buffer = (FC_Buffer*)SDL_TLSGet(fc_buffer_id);
+    if(buffer == NULL)
+    {
+        buffer = (FC_Buffer*)malloc(sizeof(FC_Buffer));
+        buffer->data = NULL;
+        buffer->size = 0;
+        buffer->lines = NULL;
+        buffer->lines_capacity = 0;
+        SDL_TLSSet(fc_buffer_id, buffer, &FC_FreeBuffer);
+    }
+
+    return buffer;
+}
+
+static char* FC_GetBuffer(void)
+{
+    FC_Buffer* buffer = FC_GetThreadBuffer();
+
+    if(buffer->size != fc_buffer_size)
+    {
+        free(buffer->data);
+        buffer->data = (char*)malloc(fc_buffer_size);
+        buffer->size = fc_buffer_size;
+    }
+
+    return buffer->data;
 }
 
 
@@ -872,19 +1216,35 @@ static void FC_Init(FC_Font* font)
     if(font->glyphs != NULL)
         FC_MapFree(font->glyphs);
 
-    font->glyphs = FC_MapCreate(FC_DEFAULT_NUM_BUCKETS);
+    font->glyphs = FC_MapCreate(FC_DEFAULT_MAP_CAPACITY);
 
     font->glyph_cache_size = 3;
     font->glyph_cache_count = 0;
 
+    font->layouts = NULL;
+    font->last_layout = NULL;
+    font->layout_index = NULL;
+    font->layout_index_count = 0;
+    font->layout_index_capacity = 0;
+    font->unresolved_layout = NULL;
+    font->deferred_glyphs = 0;
+    font->layout_cache_size = 0;
+    font->layout_cache_budget = FC_DEFAULT_LAYOUT_CACHE_BUDGET;
+
+    #ifdef FC_USE_GLYPH_BATCHING
+    font->batches = NULL;
+    font->num_batches = 0;
+    font->batch_depth = 0;
+    font->batching = 1;
+    font->draw_color = font->default_color;
+    #endif
 
     font->glyph_cache = (FC_Image**)malloc(font->glyph_cache_size * sizeof(FC_Image*));
 
     if(font->loading_string == NULL)
         font->loading_string = U8_strdup(FC_GetStringASCII());
 
-    if(fc_buffer == NULL)
-        fc_buffer = (char*)malloc(fc_buffer_size);
+    FC_InitGlobals();
 }
 
 static Uint8 FC_GrowGlyphCache(FC_Font* font)
@@ -1062,6 +1422,9 @@ FC_Font* FC_CreateFont(void)
     font = (FC_Font*)malloc(sizeof(FC_Font));
     memset(font, 0, sizeof(FC_Font));
 
+    font->mutex = SDL_CreateMutex();
+    font->render_thread = SDL_ThreadID();
+
     FC_Init(font);
 
     return font;
@@ -1099,6 +1462,7 @@ Uint8 FC_LoadFontFromTTF(FC_Font* font, SDL_Renderer* renderer, TTF_Font* ttf, S
     #endif
 
     font->ttf_source = ttf;
+    font->render_thread = SDL_ThreadID();
 
     //font->line_height = TTF_FontLineSkip(ttf);
     font->height = TTF_FontHeight(ttf);
@@ -1289,6 +1653,9 @@ void FC_ClearFont(FC_Font* font)
     font->owns_ttf_source = 0;
     font->ttf_source = NULL;
 
+    FC_ClearLayoutCache(font);
+    FC_FreeBatches(font);
+
     // Delete glyph map
     FC_MapFree(font->glyphs);
     font->glyphs = NULL;
@@ -1320,6 +1687,9 @@ void FC_FreeFont(FC_Font* font)
     if(font->owns_ttf_source)
         TTF_CloseFont(font->ttf_source);
 
+    FC_ClearLayoutCache(font);
+    FC_FreeBatches(font);
+
     // Delete glyph map
     FC_MapFree(font->glyphs);
 
@@ -1336,6 +1706,8 @@ void FC_FreeFont(FC_Font* font)
 
     free(font->loading_string);
 
+    SDL_DestroyMutex(font->mutex);
+
     free(font);
 }
 
@@ -1403,48 +1775,21 @@ Uint8 FC_AddGlyphToCache(FC_Font* font, SDL_Surface* glyph_surface)
 
 unsigned int FC_GetNumCodepoints(FC_Font* font)
 {
-    FC_Map* glyphs;
-    int i;
-    unsigned int result = 0;
     if(font == NULL || font->glyphs == NULL)
         return 0;
 
-    glyphs = font->glyphs;
-
-    for(i = 0; i < glyphs->num_buckets; ++i)
-    {
-        FC_MapNode* node;
-        for(node = glyphs->buckets[i]; node != NULL; node = node->next)
-        {
-            result++;
-        }
-    }
-
-    return result;
+    return font->glyphs->count;
 }
 
 void FC_GetCodepoints(FC_Font* font, Uint32* result)
 {
-    FC_Map* glyphs;
-    int i;
-    unsigned int count = 0;
     if(font == NULL || font->glyphs == NULL)
         return;
 
-    glyphs = font->glyphs;
-
-    for(i = 0; i < glyphs->num_buckets; ++i)
-    {
-        FC_MapNode* node;
-        for(node = glyphs->buckets[i]; node != NULL; node = node->next)
-        {
-            result[count] = node->key;
-            count++;
-        }
-    }
+    FC_MapGetKeys(font->glyphs, result);
 }
 
-Uint8 FC_GetGlyphData(FC_Font* font, FC_GlyphData* result, Uint32 codepoint)
+static Uint8 FC_FindGlyphData(FC_Font* font, FC_GlyphData* result, Uint32 codepoint)
 {
     FC_GlyphData* e = FC_MapFind(font->glyphs, codepoint);
     if(e == NULL)
@@ -1455,8 +1800,14 @@ Uint8 FC_GetGlyphData(FC_Font* font, FC_GlyphData* result, Uint32 codepoint)
         SDL_Surface* surf;
         FC_Image* cache_image;
 
+        // New glyphs are drawn into the cache textures, which only the render thread may touch
         if(font->ttf_source == NULL)
             return 0;
+        if(SDL_ThreadID() != font->render_thread)
+        {
+            font->deferred_glyphs++;
+            return 0;
+        }
 
         FC_GetUTF8FromCodepoint(buff, codepoint);
 
@@ -1508,68 +1859,512 @@ Uint8 FC_GetGlyphData(FC_Font* font, FC_GlyphData* result, Uint32 codepoint)
 }
 
 
-FC_GlyphData* FC_SetGlyphData(FC_Font* font, Uint32 codepoint, FC_GlyphData glyph_data)
+Uint8 FC_GetGlyphData(FC_Font* font, FC_GlyphData* result, Uint32 codepoint)
 {
-    return FC_MapInsert(font->glyphs, codepoint, glyph_data);
-}
+    Uint8 found;
 
+    SDL_LockMutex(font->mutex);
+    found = FC_FindGlyphData(font, result, codepoint);
+    SDL_UnlockMutex(font->mutex);
 
+    return found;
+}
 
-// Drawing
-static FC_Rect FC_RenderLeft(FC_Font* font, FC_Target* dest, float x, float y, FC_Scale scale, const char* text)
+FC_GlyphData* FC_SetGlyphData(FC_Font* font, Uint32 codepoint, FC_GlyphData glyph_data)
 {
-    const char* c = text;
-    FC_Rect srcRect;
-    FC_Rect dstRect;
-    FC_Rect dirtyRect = FC_MakeRect(x, y, 0, 0);
+    FC_GlyphData* e;
 
-    FC_GlyphData glyph;
-    Uint32 codepoint;
-
-    float destX = x;
-    float destY = y;
-    float destH;
-    float destLineSpacing;
-    float destLetterSpacing;
+    SDL_LockMutex(font->mutex);
+    e = FC_MapInsert(font->glyphs, codepoint, glyph_data);
+    FC_ClearLayoutCache(font);  // Cached layouts hold copies of the old glyph
+    SDL_UnlockMutex(font->mutex);
 
-    if(font == NULL)
-        return dirtyRect;
+    return e;
+}
 
-    destH = font->height * scale.y;
-    destLineSpacing = font->lineSpacing*scale.y;
-    destLetterSpacing = font->letterSpacing*scale.x;
 
-    if(c == NULL || font->glyph_cache_count == 0 || dest == NULL)
-        return dirtyRect;
+// Baked glyph cache file: header, packing cursor, glyph records, then one alpha plane per cache level
+#define FC_GLYPH_CACHE_MAGIC 0x43474346
+#define FC_GLYPH_CACHE_VERSION 2
+#define FC_GLYPH_CACHE_MAX_SOURCE 1024
+#define FC_GLYPH_CACHE_MAX_SIZE 4096
 
-    int newlineX = x;
+static SDL_Surface* FC_ReadGlyphCacheLevel(FC_Font* font, int cache_level)
+{
+    FC_Image* img = FC_GetGlyphCacheLevel(font, cache_level);
+    if(img == NULL)
+        return NULL;
 
-    for(; *c != '\0'; c++)
+    #ifdef FC_USE_SDL_GPU
+    return GPU_CopySurfaceFromImage(img);
+    #else
     {
-        if(*c == '\n')
-        {
-            destX = newlineX;
-            destY += destH + destLineSpacing;
-            continue;
-        }
+        SDL_Renderer* renderer = font->renderer;
+        SDL_Texture* old_target;
+        SDL_Surface* surf;
+        int w, h;
 
-        codepoint = FC_GetCodepointFromUTF8(&c, 1);  // Increments 'c' to skip the extra UTF-8 bytes
-        if(!FC_GetGlyphData(font, &glyph, codepoint))
-        {
-            codepoint = ' ';
-            if(!FC_GetGlyphData(font, &glyph, codepoint))
-                continue;  // Skip bad characters
-        }
+        // Cache levels can only be read back while they are render targets
+        if(!fc_has_render_target_support || SDL_QueryTexture(img, NULL, NULL, &w, &h) != 0)
+            return NULL;
 
-        if (codepoint == ' ')
+        surf = FC_CreateSurface32(w, h);
+        if(surf == NULL)
+            return NULL;
+
+        old_target = SDL_GetRenderTarget(renderer);
+        SDL_SetRenderTarget(renderer, img);
+        if(SDL_RenderReadPixels(renderer, NULL, surf->format->format, surf->pixels, surf->pitch) != 0)
         {
-            destX += glyph.rect.w*scale.x + destLetterSpacing;
-            continue;
+            SDL_FreeSurface(surf);
+            surf = NULL;
         }
-        /*if(destX >= dest->w)
-            continue;
-        if(destY >= dest->h)
-            continue;*/
+        SDL_SetRenderTarget(renderer, old_target);
+
+        return surf;
+    }
+    #endif
+}
+
+static void FC_WriteGlyphData(SDL_RWops* dst, FC_GlyphData glyph)
+{
+    SDL_WriteLE16(dst, (Uint16)glyph.cache_level);
+    SDL_WriteLE16(dst, (Uint16)glyph.rect.x);
+    SDL_WriteLE16(dst, (Uint16)glyph.rect.y);
+    SDL_WriteLE16(dst, (Uint16)glyph.rect.w);
+    SDL_WriteLE16(dst, (Uint16)glyph.rect.h);
+}
+
+static FC_GlyphData FC_ReadGlyphData(SDL_RWops* src)
+{
+    int cache_level = SDL_ReadLE16(src);
+    Sint16 x = (Sint16)SDL_ReadLE16(src);
+    Sint16 y = (Sint16)SDL_ReadLE16(src);
+    Uint16 w = SDL_ReadLE16(src);
+    Uint16 h = SDL_ReadLE16(src);
+    return FC_MakeGlyphData(cache_level, x, y, w, h);
+}
+
+Uint8 FC_SaveGlyphCache(FC_Font* font, SDL_RWops* dst, const char* source)
+{
+    int i;
+    unsigned int num_codepoints;
+    Uint32* codepoints;
+    Uint8* row;
+    Uint8 result = 1;
+    size_t source_length = (source == NULL? 0 : strlen(source));
+
+    if(font == NULL || dst == NULL || font->glyph_cache_count <= 0 || source_length > FC_GLYPH_CACHE_MAX_SOURCE)
+        return 0;
+
+    SDL_WriteLE32(dst, FC_GLYPH_CACHE_MAGIC);
+    SDL_WriteLE16(dst, FC_GLYPH_CACHE_VERSION);
+    SDL_WriteLE16(dst, (Uint16)source_length);
+    if(source_length > 0)
+        SDL_RWwrite(dst, source, 1, source_length);
+    SDL_WriteLE16(dst, font->height);
+    SDL_WriteLE32(dst, (Uint32)font->ascent);
+    SDL_WriteLE32(dst, (Uint32)font->descent);
+    SDL_WriteLE16(dst, font->baseline);
+    FC_WriteGlyphData(dst, font->last_glyph);
+
+    num_codepoints = FC_GetNumCodepoints(font);
+    codepoints = (Uint32*)malloc(num_codepoints * sizeof(Uint32) + 1);
+    FC_GetCodepoints(font, codepoints);
+
+    SDL_WriteLE32(dst, num_codepoints);
+    for(i = 0; i < (int)num_codepoints; ++i)
+    {
+        SDL_WriteLE32(dst, codepoints[i]);
+        FC_WriteGlyphData(dst, *FC_MapFind(font->glyphs, codepoints[i]));
+    }
+    free(codepoints);
+
+    // Glyphs are rasterized in white, so the alpha channel is all that needs storing
+    SDL_WriteLE16(dst, (Uint16)font->glyph_cache_count);
+    row = NULL;
+    for(i = 0; i < font->glyph_cache_count && result; ++i)
+    {
+        int x, y;
+        SDL_Surface* surf = FC_ReadGlyphCacheLevel(font, i);
+        if(surf == NULL)
+        {
+            result = 0;
+            break;
+        }
+
+        SDL_WriteLE16(dst, (Uint16)surf->w);
+        SDL_WriteLE16(dst, (Uint16)surf->h);
+
+        row = (Uint8*)realloc(row, surf->w);
+        for(y = 0; y < surf->h; ++y)
+        {
+            Uint32* pixels = (Uint32*)((Uint8*)surf->pixels + y*surf->pitch);
+            for(x = 0; x < surf->w; ++x)
+            {
+                Uint8 r, g, b, a;
+                SDL_GetRGBA(pixels[x], surf->format, &r, &g, &b, &a);
+                row[x] = a;
+            }
+
+            if(SDL_RWwrite(dst, row, 1, surf->w) != (size_t)surf->w)
+            {
+                result = 0;
+                break;
+            }
+        }
+
+        SDL_FreeSurface(surf);
+    }
+    free(row);
+
+    return result;
+}
+
+Uint8 FC_LoadGlyphCache(FC_Font* font, SDL_RWops* src, const char* source)
+{
+    int i;
+    FC_GlyphData cursor;
+    Uint32 num_codepoints;
+    Uint32* codepoints;
+    FC_GlyphData* glyphs;
+    int num_levels;
+    SDL_Surface* surfaces[FC_LOAD_MAX_SURFACES];
+    Uint8* row;
+    Uint8 result = 1;
+    char stored_source[FC_GLYPH_CACHE_MAX_SOURCE];
+    size_t source_length = (source == NULL? 0 : strlen(source));
+
+    if(font == NULL || src == NULL || font->glyphs == NULL)
+        return 0;
+
+    memset(surfaces, 0, sizeof(surfaces));
+
+    // Refuse caches baked from a different TTF file, size or version of it, then double-check the metrics
+    if(SDL_ReadLE32(src) != FC_GLYPH_CACHE_MAGIC || SDL_ReadLE16(src) != FC_GLYPH_CACHE_VERSION)
+        return 0;
+    if(SDL_ReadLE16(src) != source_length || source_length > FC_GLYPH_CACHE_MAX_SOURCE)
+        return 0;
+    if(source_length > 0 && (SDL_RWread(src, stored_source, 1, source_length) != source_length || memcmp(stored_source, source, source_length) != 0))
+        return 0;
+    if(SDL_ReadLE16(src) != font->height || (int)SDL_ReadLE32(src) != font->ascent
+       || (int)SDL_ReadLE32(src) != font->descent || SDL_ReadLE16(src) != font->baseline)
+        return 0;
+
+    cursor = FC_ReadGlyphData(src);
+
+    num_codepoints = SDL_ReadLE32(src);
+    if(num_codepoints > 0x10FFFF)
+        return 0;
+
+    codepoints = (Uint32*)malloc(num_codepoints * sizeof(Uint32) + 1);
+    glyphs = (FC_GlyphData*)malloc(num_codepoints * sizeof(FC_GlyphData) + 1);
+    for(i = 0; i < (int)num_codepoints; ++i)
+    {
+        codepoints[i] = SDL_ReadLE32(src);
+        glyphs[i] = FC_ReadGlyphData(src);
+    }
+
+    num_levels = SDL_ReadLE16(src);
+    if(num_levels <= 0 || num_levels > FC_LOAD_MAX_SURFACES || cursor.cache_level > num_levels)
+        result = 0;
+
+    for(i = 0; i < (int)num_codepoints && result; ++i)
+    {
+        if(glyphs[i].cache_level >= num_levels)
+            result = 0;
+    }
+
+    // Read every level before touching the font, so a truncated file leaves it as it was
+    row = NULL;
+    for(i = 0; i < num_levels && result; ++i)
+    {
+        int x, y;
+        int w = SDL_ReadLE16(src);
+        int h = SDL_ReadLE16(src);
+
+        if(w <= 0 || h <= 0 || w > FC_GLYPH_CACHE_MAX_SIZE || h > FC_GLYPH_CACHE_MAX_SIZE)
+        {
+            result = 0;
+            break;
+        }
+
+        surfaces[i] = FC_CreateSurface32(w, h);
+        row = (Uint8*)realloc(row, w);
+        for(y = 0; y < h && result; ++y)
+        {
+            Uint32* pixels = (Uint32*)((Uint8*)surfaces[i]->pixels + y*surfaces[i]->pitch);
+            if(SDL_RWread(src, row, 1, w) != (size_t)w)
+            {
+                result = 0;
+                break;
+            }
+
+            for(x = 0; x < w; ++x)
+                pixels[x] = SDL_MapRGBA(surfaces[i]->format, 255, 255, 255, row[x]);
+        }
+    }
+    free(row);
+
+    if(result)
+    {
+        // Replace whatever the loading string produced with the baked levels
+        for(i = 0; i < font->glyph_cache_count; ++i)
+        {
+            #ifdef FC_USE_SDL_GPU
+            GPU_FreeImage(font->glyph_cache[i]);
+            #else
+            SDL_DestroyTexture(font->glyph_cache[i]);
+            #endif
+        }
+        font->glyph_cache_count = 0;
+
+        FC_MapFree(font->glyphs);
+        font->glyphs = FC_MapCreate(FC_DEFAULT_MAP_CAPACITY);
+
+        for(i = 0; i < num_levels; ++i)
+        {
+            if(!FC_UploadGlyphCache(font, i, surfaces[i]))
+            {
+                result = 0;
+                break;
+            }
+            #ifndef FC_USE_SDL_GPU
+            SDL_SetTextureBlendMode(font->glyph_cache[i], SDL_BLENDMODE_BLEND);
+            #endif
+        }
+
+        for(i = 0; i < (int)num_codepoints && result; ++i)
+            FC_SetGlyphData(font, codepoints[i], glyphs[i]);
+
+        // Glyphs missing from the file are packed after the baked ones
+        font->last_glyph = cursor;
+        if(font->last_glyph.cache_level >= font->glyph_cache_count)
+            FC_GrowGlyphCache(font);
+    }
+
+    for(i = 0; i < FC_LOAD_MAX_SURFACES; ++i)
+    {
+        if(surfaces[i] != NULL)
+            SDL_FreeSurface(surfaces[i]);
+    }
+
+    free(codepoints);
+    free(glyphs);
+
+    return result;
+}
+
+
+
+// Glyph batching
+
+static void FC_FreeBatches(FC_Font* font)
+{
+    #ifdef FC_USE_GLYPH_BATCHING
+    int i;
+    for(i = 0; i < font->num_batches; ++i)
+    {
+        free(font->batches[i].vertices);
+        free(font->batches[i].indices);
+    }
+    free(font->batches);
+    font->batches = NULL;
+    font->num_batches = 0;
+    #endif
+}
+
+#ifdef FC_USE_GLYPH_BATCHING
+static_inline void FC_SetVertex(SDL_Vertex* vertex, float x, float y, SDL_Color color, float u, float v)
+{
+    vertex->position.x = x;
+    vertex->position.y = y;
+    vertex->color = color;
+    vertex->tex_coord.x = u;
+    vertex->tex_coord.y = v;
+}
+
+// Queues the same quad FC_DefaultRenderCallback would have drawn
+static FC_Rect FC_BatchGlyph(FC_Font* font, int cache_level, SDL_Rect* srcrect, float x, float y, float xscale, float yscale)
+{
+    FC_GlyphBatch* batch;
+    int base;
+    int* index;
+    float x0 = (int)x;
+    float y0 = (int)y;
+    float x1 = x0 + (int)(xscale*srcrect->w);
+    float y1 = y0 + (int)(yscale*srcrect->h);
+    float u0 = srcrect->x;
+    float v0 = srcrect->y;
+    float u1 = srcrect->x + srcrect->w;
+    float v1 = srcrect->y + srcrect->h;
+
+    if(cache_level >= font->num_batches)
+    {
+        font->batches = (FC_GlyphBatch*)realloc(font->batches, (cache_level + 1) * sizeof(FC_GlyphBatch));
+        memset(font->batches + font->num_batches, 0, (cache_level + 1 - font->num_batches) * sizeof(FC_GlyphBatch));
+        font->num_batches = cache_level + 1;
+    }
+
+    batch = &font->batches[cache_level];
+    if(batch->num_quads == batch->capacity)
+    {
+        batch->capacity = (batch->capacity == 0? FC_DEFAULT_BATCH_CAPACITY : 2*batch->capacity);
+        batch->vertices = (SDL_Vertex*)realloc(batch->vertices, 4 * batch->capacity * sizeof(SDL_Vertex));
+        batch->indices = (int*)realloc(batch->indices, 6 * batch->capacity * sizeof(int));
+    }
+
+    base = 4*batch->num_quads;
+    FC_SetVertex(&batch->vertices[base], x0, y0, font->draw_color, u0, v0);
+    FC_SetVertex(&batch->vertices[base + 1], x1, y0, font->draw_color, u1, v0);
+    FC_SetVertex(&batch->vertices[base + 2], x1, y1, font->draw_color, u1, v1);
+    FC_SetVertex(&batch->vertices[base + 3], x0, y1, font->draw_color, u0, v1);
+
+    index = &batch->indices[6*batch->num_quads];
+    index[0] = base;
+    index[1] = base + 1;
+    index[2] = base + 2;
+    index[3] = base;
+    index[4] = base + 2;
+    index[5] = base + 3;
+
+    batch->num_quads++;
+
+    return FC_MakeRect(x, y, srcrect->w*xscale, srcrect->h*yscale);
+}
+
+static void FC_FlushBatches(FC_Font* font, FC_Target* dest)
+{
+    FC_GlyphBatch* batch;
+    SDL_Texture* texture;
+    SDL_Vertex* quad;
+    SDL_Rect srcRect;
+    SDL_Rect dstRect;
+    int i, j, w, h;
+
+    for(i = 0; i < font->num_batches; ++i)
+    {
+        batch = &font->batches[i];
+        if(batch->num_quads == 0)
+            continue;
+
+        texture = FC_GetGlyphCacheLevel(font, i);
+        SDL_QueryTexture(texture, NULL, NULL, &w, &h);
+        for(j = 0; j < 4*batch->num_quads; ++j)
+        {
+            batch->vertices[j].tex_coord.x /= w;
+            batch->vertices[j].tex_coord.y /= h;
+        }
+
+        // The vertices already carry the draw color, so the texture must not apply it again
+        set_color(texture, 255, 255, 255, 255);
+        if(SDL_RenderGeometry(dest, texture, batch->vertices, 4*batch->num_quads, batch->indices, 6*batch->num_quads) < 0)
+        {
+            // Renderer can't take geometry, so copy the glyphs one at a time
+            for(j = 0; j < batch->num_quads; ++j)
+            {
+                quad = &batch->vertices[4*j];
+                srcRect.x = (int)(quad[0].tex_coord.x*w + 0.5f);
+                srcRect.y = (int)(quad[0].tex_coord.y*h + 0.5f);
+                srcRect.w = (int)(quad[2].tex_coord.x*w + 0.5f) - srcRect.x;
+                srcRect.h = (int)(quad[2].tex_coord.y*h + 0.5f) - srcRect.y;
+                dstRect.x = (int)quad[0].position.x;
+                dstRect.y = (int)quad[0].position.y;
+                dstRect.w = (int)quad[2].position.x - dstRect.x;
+                dstRect.h = (int)quad[2].position.y - dstRect.y;
+
+                set_color(texture, quad[0].color.r, quad[0].color.g, quad[0].color.b, FC_GET_ALPHA(quad[0].color));
+                SDL_RenderCopy(dest, texture, &srcRect, &dstRect);
+            }
+        }
+        set_color(texture, font->draw_color.r, font->draw_color.g, font->draw_color.b, FC_GET_ALPHA(font->draw_color));
+
+        batch->num_quads = 0;
+    }
+}
+#endif
+
+// Glyphs queued between the outermost begin and end go out together
+static void FC_BeginBatch(FC_Font* font)
+{
+    #ifdef FC_USE_GLYPH_BATCHING
+    ++font->batch_depth;
+    #endif
+}
+
+static void FC_EndBatch(FC_Font* font, FC_Target* dest)
+{
+    #ifdef FC_USE_GLYPH_BATCHING
+    if(--font->batch_depth == 0)
+        FC_FlushBatches(font, dest);
+    #endif
+}
+
+
+
+// Drawing
+static FC_Rect FC_RenderLeft(FC_Font* font, FC_Target* dest, float x, float y, FC_Scale scale, const char* text)
+{
+    const char* c = text;
+    FC_Rect srcRect;
+    FC_Rect dstRect;
+    FC_Rect dirtyRect = FC_MakeRect(x, y, 0, 0);
+
+    FC_GlyphData glyph;
+    Uint32 codepoint;
+
+    float destX = x;
+    float destY = y;
+    float destH;
+    float destLineSpacing;
+    float destLetterSpacing;
+
+    if(font == NULL)
+        return dirtyRect;
+
+    destH = font->height * scale.y;
+    destLineSpacing = font->lineSpacing*scale.y;
+    destLetterSpacing = font->letterSpacing*scale.x;
+
+    if(c == NULL || font->glyph_cache_count == 0 || dest == NULL)
+        return dirtyRect;
+
+    int newlineX = x;
+
+    #ifdef FC_USE_GLYPH_BATCHING
+    // Custom callbacks and flipped text still go through fc_render_callback
+    Uint8 batched = (font->batching && fc_render_callback == &FC_DefaultRenderCallback && scale.x > 0 && scale.y > 0);
+    #endif
+
+    // Locked once for the whole string rather than once per glyph
+    SDL_LockMutex(font->mutex);
+    FC_BeginBatch(font);
+    for(; *c != '\0'; c++)
+    {
+        if(*c == '\n')
+        {
+            destX = newlineX;
+            destY += destH + destLineSpacing;
+            continue;
+        }
+
+        codepoint = FC_GetCodepointFromUTF8(&c, 1);  // Increments 'c' to skip the extra UTF-8 bytes
+        if(!FC_FindGlyphData(font, &glyph, codepoint))
+        {
+            codepoint = ' ';
+            if(!FC_FindGlyphData(font, &glyph, codepoint))
+                continue;  // Skip bad characters
+        }
+
+        if (codepoint == ' ')
+        {
+            destX += glyph.rect.w*scale.x + destLetterSpacing;
+            continue;
+        }
+        /*if(destX >= dest->w)
+            continue;
+        if(destY >= dest->h)
+            continue;*/
 
         #ifdef FC_USE_SDL_GPU
         srcRect.x = glyph.rect.x;
@@ -1579,6 +2374,11 @@ static FC_Rect FC_RenderLeft(FC_Font* font, FC_Target* dest, float x, float y, F
         #else
         srcRect = glyph.rect;
         #endif
+        #ifdef FC_USE_GLYPH_BATCHING
+        if(batched)
+            dstRect = FC_BatchGlyph(font, glyph.cache_level, &srcRect, destX, destY, scale.x, scale.y);
+        else
+        #endif
         dstRect = fc_render_callback(FC_GetGlyphCacheLevel(font, glyph.cache_level), &srcRect, dest, destX, destY, scale.x, scale.y);
         if(dirtyRect.w == 0 || dirtyRect.h == 0)
             dirtyRect = dstRect;
@@ -1587,6 +2387,8 @@ static FC_Rect FC_RenderLeft(FC_Font* font, FC_Target* dest, float x, float y, F
 
         destX += glyph.rect.w*scale.x + destLetterSpacing;
     }
+    FC_EndBatch(font, dest);
+    SDL_UnlockMutex(font->mutex);
 
     return dirtyRect;
 }
@@ -1602,6 +2404,10 @@ static void set_color_for_all_caches(FC_Font* font, SDL_Color color)
         img = FC_GetGlyphCacheLevel(font, i);
         set_color(img, color.r, color.g, color.b, FC_GET_ALPHA(color));
     }
+
+    #ifdef FC_USE_GLYPH_BATCHING
+    font->draw_color = color;
+    #endif
 }
 
 FC_Rect FC_Draw(FC_Font* font, FC_Target* dest, float x, float y, const char* formatted_text, ...)
@@ -1609,6 +2415,7 @@ FC_Rect FC_Draw(FC_Font* font, FC_Target* dest, float x, float y, const char* fo
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(x, y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     set_color_for_all_caches(font, font->default_color);
@@ -1618,215 +2425,442 @@ FC_Rect FC_Draw(FC_Font* font, FC_Target* dest, float x, float y, const char* fo
 
 
 
-typedef struct FC_StringList
+// Width of the widest line within the first length bytes of text
+static Uint16 FC_MeasureSpan(FC_Font* font, FC_MeasureEnum measure, const char* text, int length)
 {
-    char* value;
-    struct FC_StringList* next;
-} FC_StringList;
+    const char* c;
+    const char* end = text + length;
+    Uint16 width = 0;
+    Uint16 bigWidth = 0;  // Allows for multi-line strings
 
-void FC_StringListFree(FC_StringList* node)
-{
-    // Delete the nodes in order
-    while(node != NULL)
+    SDL_LockMutex(font->mutex);
+    for(c = text; c < end; c++)
     {
-        FC_StringList* last = node;
-        node = node->next;
+        // Plain ASCII comes straight from the width table, the decoder picks up whatever stopped it
+        if(measure == FC_MEASURE_TABLE)
+        {
+            Uint32 run_width = 0;
+            c += fc_ascii_measurer->measure(font->glyphs->ascii_widths, c, end - c, &run_width);
+            width += run_width;
+            if(c >= end)
+                break;
+        }
+
+        if(*c == '\n')
+        {
+            bigWidth = bigWidth >= width? bigWidth : width;
+            width = 0;
+            continue;
+        }
 
-        free(last->value);
-        free(last);
+        FC_GlyphData glyph;
+        Uint32 codepoint = FC_GetCodepointFromUTF8(&c, 1);
+        if(FC_FindGlyphData(font, &glyph, codepoint) || FC_FindGlyphData(font, &glyph, ' '))
+            width += glyph.rect.w;
     }
+    SDL_UnlockMutex(font->mutex);
+    bigWidth = bigWidth >= width? bigWidth : width;
+
+    return bigWidth;
 }
 
-FC_StringList** FC_StringListPushBack(FC_StringList** node, char* value, Uint8 copy)
+static Uint16 FC_GetSpanWidth(FC_Font* font, const char* text, int length)
 {
-    // Get to the last node
-    while(node != NULL && *node != NULL)
-    {
-        node = &(*node)->next;
-    }
+    return FC_MeasureSpan(font, FC_MEASURE_TABLE, text, length);
+}
 
-    *node = (FC_StringList*)malloc(sizeof(FC_StringList));
+static Uint16 FC_GetLineBreakWidth(FC_Font* font, const char* text, const FC_LineBreak* line)
+{
+    Uint16 width = FC_GetSpanWidth(font, text + line->start, line->length);
+    if(line->space)
+        width += FC_GetSpanWidth(font, " ", 1);
+    return width;
+}
 
-    (*node)->value = (copy? U8_strdup(value) : value);
-    (*node)->next = NULL;
+static FC_LineBreak* FC_PushLineBreak(FC_Buffer* buffer, int* num_lines, int start, int length, Uint8 space)
+{
+    FC_LineBreak* line;
+
+    if(*num_lines == buffer->lines_capacity)
+    {
+        buffer->lines_capacity = (buffer->lines_capacity == 0? 16 : 2*buffer->lines_capacity);
+        buffer->lines = (FC_LineBreak*)realloc(buffer->lines, buffer->lines_capacity * sizeof(FC_LineBreak));
+    }
 
-    return node;
+    line = &buffer->lines[(*num_lines)++];
+    line->start = start;
+    line->length = length;
+    line->space = space;
+    return line;
 }
 
-static FC_StringList* FC_Explode(const char* text, char delimiter)
+// Splits text on newlines, then wraps each line word by word to fit width (no limit if width <= 0).
+// With keep_newlines, every line after the first starts with its '\n'.
+// The result lives in this thread's scratch buffer until the next call.
+static FC_LineBreak* FC_BreakLines(FC_Font* font, const char* text, int width, Uint8 keep_newlines, int* num_lines)
 {
-    FC_StringList* head;
-    FC_StringList* new_node;
-    FC_StringList** node;
-    const char* start;
-    const char* end;
-    unsigned int size;
-    if(text == NULL)
-        return NULL;
+    FC_Buffer* buffer = FC_GetThreadBuffer();
+    Uint16 space_width = FC_GetSpanWidth(font, " ", 1);
+    const char* line = text;
+    const char* line_end = text;
 
-    head = NULL;
-    node = &head;
-
-    // Doesn't technically support UTF-8, but it's probably fine, right?
-    size = 0;
-    start = end = text;
+    *num_lines = 0;
     while(1)
     {
-        if(*end == delimiter || *end == '\0')
+        while(*line_end != '\n' && *line_end != '\0')
+            ++line_end;
+
+        // If line is too long, then add words one at a time until we go over.
+        if(width > 0 && FC_GetSpanWidth(font, line, line_end - line) > width)
         {
-            *node = (FC_StringList*)malloc(sizeof(FC_StringList));
-            new_node = *node;
+            const char* start = line;
+            const char* word = line;
+            const char* word_end = line;
+            Uint16 line_width;
 
-            new_node->value = (char*)malloc(size + 1);
-            memcpy(new_node->value, start, size);
-            new_node->value[size] = '\0';
+            // The first word always stays on the line, however long it is
+            while(word_end < line_end && *word_end != ' ')
+                ++word_end;
+            line_width = FC_GetSpanWidth(font, word, word_end - word) + space_width;
 
-            new_node->next = NULL;
+            while(word_end < line_end)
+            {
+                Uint16 word_width;
 
-            if(*end == '\0')
-                break;
+                word = word_end + 1;
+                for(word_end = word; word_end < line_end && *word_end != ' '; ++word_end)
+                    ;
+                word_width = FC_GetSpanWidth(font, word, word_end - word);
 
-            node = &((*node)->next);
-            start = end+1;
-            size = 0;
+                if(line_width + word_width > width)
+                {
+                    FC_PushLineBreak(buffer, num_lines, start - text, word - start, 0);
+                    start = word;
+                    line_width = word_width + space_width;
+                }
+                else
+                    line_width += word_width + space_width;
+            }
+            FC_PushLineBreak(buffer, num_lines, start - text, line_end - start, 1);
         }
         else
-            ++size;
+            FC_PushLineBreak(buffer, num_lines, line - text, line_end - line, 0);
 
-        ++end;
+        if(*line_end == '\0')
+            break;
+
+        // A kept newline belongs to the line it starts
+        line = (keep_newlines? line_end : line_end + 1);
+        ++line_end;
     }
 
-    return head;
+    return buffer->lines;
 }
 
-static FC_StringList* FC_ExplodeAndKeep(const char* text, char delimiter)
+static Uint32 FC_HashString(const char* text)
 {
-    FC_StringList* head;
-    FC_StringList* new_node;
-    FC_StringList** node;
-    const char* start;
-    const char* end;
-    unsigned int size;
-    if(text == NULL)
-        return NULL;
+    Uint32 hash = 2166136261u;
+    for(; *text != '\0'; ++text)
+        hash = (hash ^ (Uint8)*text) * 16777619u;
+    return hash;
+}
+
+static_inline Uint32 FC_LayoutSlot(FC_Font* font, Uint32 hash, int width)
+{
+    return ((hash ^ (Uint32)width) * 2654435769u) & (font->layout_index_capacity - 1);
+}
 
-    head = NULL;
-    node = &head;
+// Returns the slot holding the matching layout, or the free slot where it belongs
+static FC_Layout** FC_ProbeLayoutIndex(FC_Font* font, Uint32 hash, int width, const char* text)
+{
+    Uint32 index = FC_LayoutSlot(font, hash, width);
+    FC_Layout* layout;
 
-    // Doesn't technically support UTF-8, but it's probably fine, right?
-    size = 0;
-    start = end = text;
-    while(1)
+    // Like FC_Map, the table is never more than half full
+    while((layout = font->layout_index[index]) != NULL)
     {
-        if(*end == delimiter || *end == '\0')
-        {
-            *node = (FC_StringList*)malloc(sizeof(FC_StringList));
-            new_node = *node;
+        if(layout->hash == hash && layout->width == width && strcmp(layout->text, text) == 0)
+            break;
+        index = (index + 1) & (font->layout_index_capacity - 1);
+    }
 
-            new_node->value = (char*)malloc(size + 1);
-            memcpy(new_node->value, start, size);
-            new_node->value[size] = '\0';
+    return &font->layout_index[index];
+}
 
-            new_node->next = NULL;
+static void FC_AllocLayoutIndex(FC_Font* font, int capacity)
+{
+    font->layout_index_capacity = capacity;
+    font->layout_index = (FC_Layout**)calloc(capacity, sizeof(FC_Layout*));
+}
 
-            if(*end == '\0')
-                break;
+static void FC_InsertLayoutIndex(FC_Font* font, FC_Layout* layout)
+{
+    if(2*(font->layout_index_count + 1) > font->layout_index_capacity)
+    {
+        int i;
+        int old_capacity = font->layout_index_capacity;
+        FC_Layout** old_index = font->layout_index;
 
-            node = &((*node)->next);
-            start = end;
-            size = 1;
+        FC_AllocLayoutIndex(font, old_capacity > 0? 2*old_capacity : FC_DEFAULT_MAP_CAPACITY);
+        for(i = 0; i < old_capacity; ++i)
+        {
+            if(old_index[i] != NULL)
+                *FC_ProbeLayoutIndex(font, old_index[i]->hash, old_index[i]->width, old_index[i]->text) = old_index[i];
         }
-        else
-            ++size;
-
-        ++end;
+        free(old_index);
     }
 
-    return head;
+    *FC_ProbeLayoutIndex(font, layout->hash, layout->width, layout->text) = layout;
+    font->layout_index_count++;
 }
 
-static void FC_RenderAlign(FC_Font* font, FC_Target* dest, float x, float y, int width, FC_Scale scale, FC_AlignEnum align, const char* text)
+static void FC_RemoveLayoutIndex(FC_Font* font, FC_Layout* layout)
 {
-    switch(align)
+    Uint32 mask = font->layout_index_capacity - 1;
+    Uint32 hole = (Uint32)(FC_ProbeLayoutIndex(font, layout->hash, layout->width, layout->text) - font->layout_index);
+    Uint32 index = hole;
+
+    // Shift later entries of the probe run back so lookups never stop at the hole early
+    font->layout_index[hole] = NULL;
+    while(1)
     {
-        case FC_ALIGN_LEFT:
-            FC_RenderLeft(font, dest, x, y, scale, text);
-            break;
-        case FC_ALIGN_CENTER:
-            FC_RenderCenter(font, dest, x + width/2, y, scale, text);
-            break;
-        case FC_ALIGN_RIGHT:
-            FC_RenderRight(font, dest, x + width, y, scale, text);
+        FC_Layout* next;
+        Uint32 home;
+
+        index = (index + 1) & mask;
+        next = font->layout_index[index];
+        if(next == NULL)
             break;
+
+        home = FC_LayoutSlot(font, next->hash, next->width);
+        if(((index - home) & mask) >= ((index - hole) & mask))
+        {
+            font->layout_index[hole] = next;
+            font->layout_index[index] = NULL;
+            hole = index;
+        }
     }
+
+    font->layout_index_count--;
 }
 
-static FC_StringList* FC_GetBufferFitToColumn(FC_Font* font, int width, FC_Scale scale, Uint8 keep_newlines)
+static void FC_UnlinkLayout(FC_Font* font, FC_Layout* layout)
 {
-    FC_StringList* result = NULL;
-    FC_StringList** current = &result;
+    if(layout->prev != NULL)
+        layout->prev->next = layout->next;
+    else
+        font->layouts = layout->next;
+
+    if(layout->next != NULL)
+        layout->next->prev = layout->prev;
+    else
+        font->last_layout = layout->prev;
 
-    FC_StringList *ls, *iter;
+    layout->prev = layout->next = NULL;
+}
 
-    ls = (keep_newlines? FC_ExplodeAndKeep(fc_buffer, '\n') : FC_Explode(fc_buffer, '\n'));
-    for(iter = ls; iter != NULL; iter = iter->next)
+static void FC_FreeLayout(FC_Layout* layout)
+{
+    free(layout->text);
+    free(layout->lines);
+    free(layout->glyphs);
+    free(layout);
+}
+
+// Frees layouts from the tail until the cache fits its budget, but never keep
+static void FC_EvictLayouts(FC_Font* font, FC_Layout* keep)
+{
+    while(font->layout_cache_size > font->layout_cache_budget && font->last_layout != NULL && font->last_layout != keep)
     {
-        char* line = iter->value;
+        FC_Layout* last = font->last_layout;
+        FC_UnlinkLayout(font, last);
+        FC_RemoveLayoutIndex(font, last);
+        font->layout_cache_size -= last->size;
+        FC_FreeLayout(last);
+    }
+}
 
-        // If line is too long, then add words one at a time until we go over.
-        if(width > 0 && FC_GetWidth(font, "%s", line) > width)
-        {
-            FC_StringList *words, *word_iter;
+static void FC_ClearLayoutCache(FC_Font* font)
+{
+    while(font->layouts != NULL)
+    {
+        FC_Layout* layout = font->layouts;
+        FC_UnlinkLayout(font, layout);
+        FC_FreeLayout(layout);
+    }
+    font->layout_cache_size = 0;
+
+    free(font->layout_index);
+    font->layout_index = NULL;
+    font->layout_index_count = 0;
+    font->layout_index_capacity = 0;
+
+    if(font->unresolved_layout != NULL)
+        FC_FreeLayout(font->unresolved_layout);
+    font->unresolved_layout = NULL;
+}
+
+static FC_Layout* FC_CreateLayout(FC_Font* font, const char* text, int width)
+{
+    FC_LineBreak* lines;
+    FC_GlyphData glyph;
+    Uint32 codepoint;
+    unsigned int text_size;
+    int num_glyphs = 0;
+    int i;
+    FC_Layout* layout = (FC_Layout*)malloc(sizeof(FC_Layout));
+
+    layout->hash = FC_HashString(text);
+    layout->width = width;
+    layout->text = U8_strdup(text);
+    layout->prev = layout->next = NULL;
+    text_size = strlen(layout->text) + 1;
+
+    // Scale doesn't take part in wrapping or placing, so one layout serves every scale
+    lines = FC_BreakLines(font, layout->text, width, 0, &layout->num_lines);
+    layout->lines = (FC_LayoutLine*)malloc(layout->num_lines * sizeof(FC_LayoutLine));
+    layout->glyphs = (FC_LayoutGlyph*)malloc(text_size * sizeof(FC_LayoutGlyph));  // No more glyphs than bytes
+    for(i = 0; i < layout->num_lines; ++i)
+    {
+        const char* c = layout->text + lines[i].start;
+        const char* end = c + lines[i].length;
+        float x = 0;
+
+        layout->lines[i].first_glyph = num_glyphs;
+        layout->lines[i].width = FC_GetLineBreakWidth(font, layout->text, &lines[i]);
 
-            words = FC_Explode(line, ' ');
-            // Skip the first word for the iterator, so there will always be at least one word per line
-            line = new_concat(words->value, " ");
-            for(word_iter = words->next; word_iter != NULL; word_iter = word_iter->next)
+        // The same walk FC_RenderLeft() does, minus the drawing
+        for(; c < end; c++)
+        {
+            codepoint = FC_GetCodepointFromUTF8(&c, 1);
+            if(!FC_FindGlyphData(font, &glyph, codepoint))
             {
-                char* line_plus_word = new_concat(line, word_iter->value);
-                char* word_plus_space = new_concat(word_iter->value, " ");
-                if(FC_GetWidth(font, "%s", line_plus_word) > width)
-                {
-                    current = FC_StringListPushBack(current, line, 0);
+                codepoint = ' ';
+                if(!FC_FindGlyphData(font, &glyph, codepoint))
+                    continue;
+            }
 
-                    line = word_plus_space;
-                }
-                else
-                {
-                    replace_concat(&line, word_plus_space);
-                    free(word_plus_space);
-                }
-                free(line_plus_word);
+            if(codepoint != ' ')
+            {
+                layout->glyphs[num_glyphs].x = x;
+                layout->glyphs[num_glyphs].data = glyph;
+                num_glyphs++;
             }
-            current = FC_StringListPushBack(current, line, 0);
-            FC_StringListFree(words);
+            x += glyph.rect.w + font->letterSpacing;
         }
-        else
+
+        layout->lines[i].num_glyphs = num_glyphs - layout->lines[i].first_glyph;
+    }
+
+    layout->height = layout->num_lines * FC_GetLineHeight(font);
+    layout->size = sizeof(FC_Layout) + text_size + layout->num_lines * sizeof(FC_LayoutLine) + num_glyphs * sizeof(FC_LayoutGlyph);
+    return layout;
+}
+
+// Wraps text to the given width, reusing the layout from an earlier call with the same text.
+// The result is only valid while the caller holds the font mutex.
+static FC_Layout* FC_GetLayout(FC_Font* font, const char* text, int width)
+{
+    FC_Layout* layout = NULL;
+
+    if(font->unresolved_layout != NULL)
+    {
+        FC_FreeLayout(font->unresolved_layout);
+        font->unresolved_layout = NULL;
+    }
+
+    if(font->layout_index_count > 0)
+        layout = *FC_ProbeLayoutIndex(font, FC_HashString(text), width, text);
+
+    if(layout == NULL)
+    {
+        unsigned int deferred_glyphs = font->deferred_glyphs;
+
+        layout = FC_CreateLayout(font, text, width);
+
+        // Glyphs measured as spaces off the render thread would break lines wrongly for good
+        if(font->deferred_glyphs != deferred_glyphs)
         {
-            current = FC_StringListPushBack(current, line, 0);
-            iter->value = NULL;
+            font->unresolved_layout = layout;
+            return layout;
         }
+
+        font->layout_cache_size += layout->size;
+        FC_InsertLayoutIndex(font, layout);
     }
-    FC_StringListFree(ls);
+    else
+        FC_UnlinkLayout(font, layout);
 
-    return result;
+    layout->next = font->layouts;
+    if(font->layouts != NULL)
+        font->layouts->prev = layout;
+    else
+        font->last_layout = layout;
+    font->layouts = layout;
+
+    // Never evict the layout the caller is about to use
+    FC_EvictLayouts(font, layout);
+
+    return layout;
 }
 
-static void FC_DrawColumnFromBuffer(FC_Font* font, FC_Target* dest, FC_Rect box, int* total_height, FC_Scale scale, FC_AlignEnum align)
+static void FC_DrawColumnFromText(FC_Font* font, FC_Target* dest, FC_Rect box, int* total_height, FC_Scale scale, FC_AlignEnum align, const char* text)
 {
-    int y = box.y;
-    FC_StringList *ls, *iter;
+    FC_Rect srcRect;
+    FC_Layout* layout;
+    int i, j;
+
+    // Held while drawing so no other thread evicts the layout under us
+    SDL_LockMutex(font->mutex);
+    layout = FC_GetLayout(font, text, box.w);
+    if(total_height != NULL)
+        *total_height = layout->height;
 
-    ls = FC_GetBufferFitToColumn(font, box.w, scale, 0);
-    for(iter = ls; iter != NULL; iter = iter->next)
+    if(font->glyph_cache_count == 0 || dest == NULL)
     {
-        FC_RenderAlign(font, dest, box.x, y, box.w, scale, align, iter->value);
-        y += FC_GetLineHeight(font);
+        SDL_UnlockMutex(font->mutex);
+        return;
     }
-    FC_StringListFree(ls);
 
-    if(total_height != NULL)
-        *total_height = y - box.y;
+    #ifdef FC_USE_GLYPH_BATCHING
+    Uint8 batched = (font->batching && fc_render_callback == &FC_DefaultRenderCallback && scale.x > 0 && scale.y > 0);
+    #endif
+
+    FC_BeginBatch(font);
+    for(i = 0; i < layout->num_lines; ++i)
+    {
+        const FC_LayoutLine* line = &layout->lines[i];
+        float x = box.x;
+        float y = box.y + i*FC_GetLineHeight(font);
+
+        // Same offsets FC_RenderCenter() and FC_RenderRight() use
+        if(align == FC_ALIGN_CENTER)
+            x += box.w/2 - scale.x*line->width/2.0f;
+        else if(align == FC_ALIGN_RIGHT)
+            x += box.w - scale.x*line->width;
+
+        for(j = line->first_glyph; j < line->first_glyph + line->num_glyphs; ++j)
+        {
+            const FC_LayoutGlyph* glyph = &layout->glyphs[j];
+
+            #ifdef FC_USE_SDL_GPU
+            srcRect.x = glyph->data.rect.x;
+            srcRect.y = glyph->data.rect.y;
+            srcRect.w = glyph->data.rect.w;
+            srcRect.h = glyph->data.rect.h;
+            #else
+            srcRect = glyph->data.rect;
+            #endif
+            #ifdef FC_USE_GLYPH_BATCHING
+            if(batched)
+                FC_BatchGlyph(font, glyph->data.cache_level, &srcRect, x + glyph->x*scale.x, y, scale.x, scale.y);
+            else
+            #endif
+            fc_render_callback(FC_GetGlyphCacheLevel(font, glyph->data.cache_level), &srcRect, dest, x + glyph->x*scale.x, y, scale.x, scale.y);
+        }
+    }
+    FC_EndBatch(font, dest);
+    SDL_UnlockMutex(font->mutex);
 }
 
 FC_Rect FC_DrawBox(FC_Font* font, FC_Target* dest, FC_Rect box, const char* formatted_text, ...)
@@ -1835,6 +2869,7 @@ FC_Rect FC_DrawBox(FC_Font* font, FC_Target* dest, FC_Rect box, const char* form
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(box.x, box.y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     useClip = has_clip(dest);
@@ -1851,7 +2886,7 @@ FC_Rect FC_DrawBox(FC_Font* font, FC_Target* dest, FC_Rect box, const char* form
 
     set_color_for_all_caches(font, font->default_color);
 
-    FC_DrawColumnFromBuffer(font, dest, box, NULL, FC_MakeScale(1,1), FC_ALIGN_LEFT);
+    FC_DrawColumnFromText(font, dest, box, NULL, FC_MakeScale(1,1), FC_ALIGN_LEFT, fc_buffer);
 
     if(useClip)
         set_clip(dest, &oldclip);
@@ -1867,6 +2902,7 @@ FC_Rect FC_DrawBoxAlign(FC_Font* font, FC_Target* dest, FC_Rect box, FC_AlignEnu
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(box.x, box.y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     useClip = has_clip(dest);
@@ -1882,7 +2918,7 @@ FC_Rect FC_DrawBoxAlign(FC_Font* font, FC_Target* dest, FC_Rect box, FC_AlignEnu
 
     set_color_for_all_caches(font, font->default_color);
 
-    FC_DrawColumnFromBuffer(font, dest, box, NULL, FC_MakeScale(1,1), align);
+    FC_DrawColumnFromText(font, dest, box, NULL, FC_MakeScale(1,1), align, fc_buffer);
 
     if(useClip)
         set_clip(dest, &oldclip);
@@ -1898,6 +2934,7 @@ FC_Rect FC_DrawBoxScale(FC_Font* font, FC_Target* dest, FC_Rect box, FC_Scale sc
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(box.x, box.y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     useClip = has_clip(dest);
@@ -1913,7 +2950,7 @@ FC_Rect FC_DrawBoxScale(FC_Font* font, FC_Target* dest, FC_Rect box, FC_Scale sc
 
     set_color_for_all_caches(font, font->default_color);
 
-    FC_DrawColumnFromBuffer(font, dest, box, NULL, scale, FC_ALIGN_LEFT);
+    FC_DrawColumnFromText(font, dest, box, NULL, scale, FC_ALIGN_LEFT, fc_buffer);
 
     if(useClip)
         set_clip(dest, &oldclip);
@@ -1929,6 +2966,7 @@ FC_Rect FC_DrawBoxColor(FC_Font* font, FC_Target* dest, FC_Rect box, SDL_Color c
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(box.x, box.y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     useClip = has_clip(dest);
@@ -1944,7 +2982,7 @@ FC_Rect FC_DrawBoxColor(FC_Font* font, FC_Target* dest, FC_Rect box, SDL_Color c
 
     set_color_for_all_caches(font, color);
 
-    FC_DrawColumnFromBuffer(font, dest, box, NULL, FC_MakeScale(1,1), FC_ALIGN_LEFT);
+    FC_DrawColumnFromText(font, dest, box, NULL, FC_MakeScale(1,1), FC_ALIGN_LEFT, fc_buffer);
 
     if(useClip)
         set_clip(dest, &oldclip);
@@ -1956,12 +2994,21 @@ FC_Rect FC_DrawBoxColor(FC_Font* font, FC_Target* dest, FC_Rect box, SDL_Color c
 
 FC_Rect FC_DrawBoxEffect(FC_Font* font, FC_Target* dest, FC_Rect box, FC_Effect effect, const char* formatted_text, ...)
 {
-    Uint8 useClip;
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(box.x, box.y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
+    return FC_DrawBoxText(font, dest, box, effect, fc_buffer);
+}
+
+FC_Rect FC_DrawBoxText(FC_Font* font, FC_Target* dest, FC_Rect box, FC_Effect effect, const char* text)
+{
+    Uint8 useClip;
+    if(text == NULL || font == NULL)
+        return FC_MakeRect(box.x, box.y, 0, 0);
+
     useClip = has_clip(dest);
     FC_Rect oldclip, newclip;
     if(useClip)
@@ -1975,7 +3022,7 @@ FC_Rect FC_DrawBoxEffect(FC_Font* font, FC_Target* dest, FC_Rect box, FC_Effect
 
     set_color_for_all_caches(font, effect.color);
 
-    FC_DrawColumnFromBuffer(font, dest, box, NULL, effect.scale, effect.alignment);
+    FC_DrawColumnFromText(font, dest, box, NULL, effect.scale, effect.alignment, text);
 
     if(useClip)
         set_clip(dest, &oldclip);
@@ -1993,11 +3040,12 @@ FC_Rect FC_DrawColumn(FC_Font* font, FC_Target* dest, float x, float y, Uint16 w
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(x, y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     set_color_for_all_caches(font, font->default_color);
 
-    FC_DrawColumnFromBuffer(font, dest, box, &total_height, FC_MakeScale(1,1), FC_ALIGN_LEFT);
+    FC_DrawColumnFromText(font, dest, box, &total_height, FC_MakeScale(1,1), FC_ALIGN_LEFT, fc_buffer);
 
     return FC_MakeRect(box.x, box.y, width, total_height);
 }
@@ -2010,6 +3058,7 @@ FC_Rect FC_DrawColumnAlign(FC_Font* font, FC_Target* dest, float x, float y, Uin
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(x, y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     set_color_for_all_caches(font, font->default_color);
@@ -2026,7 +3075,7 @@ FC_Rect FC_DrawColumnAlign(FC_Font* font, FC_Target* dest, float x, float y, Uin
         break;
     }
 
-    FC_DrawColumnFromBuffer(font, dest, box, &total_height, FC_MakeScale(1,1), align);
+    FC_DrawColumnFromText(font, dest, box, &total_height, FC_MakeScale(1,1), align, fc_buffer);
 
     return FC_MakeRect(box.x, box.y, width, total_height);
 }
@@ -2039,11 +3088,12 @@ FC_Rect FC_DrawColumnScale(FC_Font* font, FC_Target* dest, float x, float y, Uin
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(x, y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     set_color_for_all_caches(font, font->default_color);
 
-    FC_DrawColumnFromBuffer(font, dest, box, &total_height, scale, FC_ALIGN_LEFT);
+    FC_DrawColumnFromText(font, dest, box, &total_height, scale, FC_ALIGN_LEFT, fc_buffer);
 
     return FC_MakeRect(box.x, box.y, width, total_height);
 }
@@ -2056,11 +3106,12 @@ FC_Rect FC_DrawColumnColor(FC_Font* font, FC_Target* dest, float x, float y, Uin
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(x, y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     set_color_for_all_caches(font, color);
 
-    FC_DrawColumnFromBuffer(font, dest, box, &total_height, FC_MakeScale(1,1), FC_ALIGN_LEFT);
+    FC_DrawColumnFromText(font, dest, box, &total_height, FC_MakeScale(1,1), FC_ALIGN_LEFT, fc_buffer);
 
     return FC_MakeRect(box.x, box.y, width, total_height);
 }
@@ -2073,6 +3124,7 @@ FC_Rect FC_DrawColumnEffect(FC_Font* font, FC_Target* dest, float x, float y, Ui
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(x, y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     set_color_for_all_caches(font, effect.color);
@@ -2089,7 +3141,7 @@ FC_Rect FC_DrawColumnEffect(FC_Font* font, FC_Target* dest, float x, float y, Ui
         break;
     }
 
-    FC_DrawColumnFromBuffer(font, dest, box, &total_height, effect.scale, effect.alignment);
+    FC_DrawColumnFromText(font, dest, box, &total_height, effect.scale, effect.alignment, fc_buffer);
 
     return FC_MakeRect(box.x, box.y, width, total_height);
 }
@@ -2104,6 +3156,9 @@ static FC_Rect FC_RenderCenter(FC_Font* font, FC_Target* dest, float x, float y,
     char* del = str;
     char* c;
 
+    SDL_LockMutex(font->mutex);
+    FC_BeginBatch(font);
+
     // Go through str, when you find a \n, replace it with \0 and print it
     // then move down, back, and continue.
     for(c = str; *c != '\0';)
@@ -2111,7 +3166,7 @@ static FC_Rect FC_RenderCenter(FC_Font* font, FC_Target* dest, float x, float y,
         if(*c == '\n')
         {
             *c = '\0';
-            result = FC_RectUnion(FC_RenderLeft(font, dest, x - scale.x*FC_GetWidth(font, "%s", str)/2.0f, y, scale, str), result);
+            result = FC_RectUnion(FC_RenderLeft(font, dest, x - scale.x*FC_GetTextWidth(font, str)/2.0f, y, scale, str), result);
             *c = '\n';
             c++;
             str = c;
@@ -2121,7 +3176,10 @@ static FC_Rect FC_RenderCenter(FC_Font* font, FC_Target* dest, float x, float y,
             c++;
     }
 
-    result = FC_RectUnion(FC_RenderLeft(font, dest, x - scale.x*FC_GetWidth(font, "%s", str)/2.0f, y, scale, str), result);
+    result = FC_RectUnion(FC_RenderLeft(font, dest, x - scale.x*FC_GetTextWidth(font, str)/2.0f, y, scale, str), result);
+
+    FC_EndBatch(font, dest);
+    SDL_UnlockMutex(font->mutex);
 
     free(del);
     return result;
@@ -2137,12 +3195,15 @@ static FC_Rect FC_RenderRight(FC_Font* font, FC_Target* dest, float x, float y,
     char* del = str;
     char* c;
 
+    SDL_LockMutex(font->mutex);
+    FC_BeginBatch(font);
+
     for(c = str; *c != '\0';)
     {
         if(*c == '\n')
         {
             *c = '\0';
-            result = FC_RectUnion(FC_RenderLeft(font, dest, x - scale.x*FC_GetWidth(font, "%s", str), y, scale, str), result);
+            result = FC_RectUnion(FC_RenderLeft(font, dest, x - scale.x*FC_GetTextWidth(font, str), y, scale, str), result);
             *c = '\n';
             c++;
             str = c;
@@ -2152,7 +3213,10 @@ static FC_Rect FC_RenderRight(FC_Font* font, FC_Target* dest, float x, float y,
             c++;
     }
 
-    result = FC_RectUnion(FC_RenderLeft(font, dest, x - scale.x*FC_GetWidth(font, "%s", str), y, scale, str), result);
+    result = FC_RectUnion(FC_RenderLeft(font, dest, x - scale.x*FC_GetTextWidth(font, str), y, scale, str), result);
+
+    FC_EndBatch(font, dest);
+    SDL_UnlockMutex(font->mutex);
 
     free(del);
     return result;
@@ -2165,6 +3229,7 @@ FC_Rect FC_DrawScale(FC_Font* font, FC_Target* dest, float x, float y, FC_Scale
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(x, y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     set_color_for_all_caches(font, font->default_color);
@@ -2177,6 +3242,7 @@ FC_Rect FC_DrawAlign(FC_Font* font, FC_Target* dest, float x, float y, FC_AlignE
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(x, y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     set_color_for_all_caches(font, font->default_color);
@@ -2206,6 +3272,7 @@ FC_Rect FC_DrawColor(FC_Font* font, FC_Target* dest, float x, float y, SDL_Color
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(x, y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     set_color_for_all_caches(font, color);
@@ -2219,21 +3286,30 @@ FC_Rect FC_DrawEffect(FC_Font* font, FC_Target* dest, float x, float y, FC_Effec
     if(formatted_text == NULL || font == NULL)
         return FC_MakeRect(x, y, 0, 0);
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
+    return FC_DrawText(font, dest, x, y, effect, fc_buffer);
+}
+
+FC_Rect FC_DrawText(FC_Font* font, FC_Target* dest, float x, float y, FC_Effect effect, const char* text)
+{
+    if(text == NULL || font == NULL)
+        return FC_MakeRect(x, y, 0, 0);
+
     set_color_for_all_caches(font, effect.color);
 
     FC_Rect result;
     switch(effect.alignment)
     {
         case FC_ALIGN_LEFT:
-            result = FC_RenderLeft(font, dest, x, y, effect.scale, fc_buffer);
+            result = FC_RenderLeft(font, dest, x, y, effect.scale, text);
             break;
         case FC_ALIGN_CENTER:
-            result = FC_RenderCenter(font, dest, x, y, effect.scale, fc_buffer);
+            result = FC_RenderCenter(font, dest, x, y, effect.scale, text);
             break;
         case FC_ALIGN_RIGHT:
-            result = FC_RenderRight(font, dest, x, y, effect.scale, fc_buffer);
+            result = FC_RenderRight(font, dest, x, y, effect.scale, text);
             break;
         default:
             result = FC_MakeRect(x, y, 0, 0);
@@ -2270,6 +3346,7 @@ Uint16 FC_GetHeight(FC_Font* font, const char* formatted_text, ...)
     if(formatted_text == NULL || font == NULL)
         return 0;
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     Uint16 numLines = 1;
@@ -2290,75 +3367,83 @@ Uint16 FC_GetWidth(FC_Font* font, const char* formatted_text, ...)
     if(formatted_text == NULL || font == NULL)
         return 0;
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
-    const char* c;
-    Uint16 width = 0;
-    Uint16 bigWidth = 0;  // Allows for multi-line strings
+    return FC_GetTextWidth(font, fc_buffer);
+}
 
-    for (c = fc_buffer; *c != '\0'; c++)
-    {
-        if(*c == '\n')
-        {
-            bigWidth = bigWidth >= width? bigWidth : width;
-            width = 0;
-            continue;
-        }
+Uint16 FC_GetTextWidth(FC_Font* font, const char* text)
+{
+    if(text == NULL || font == NULL)
+        return 0;
 
-        FC_GlyphData glyph;
-        Uint32 codepoint = FC_GetCodepointFromUTF8(&c, 1);
-        if(FC_GetGlyphData(font, &glyph, codepoint) || FC_GetGlyphData(font, &glyph, ' '))
-            width += glyph.rect.w;
-    }
-    bigWidth = bigWidth >= width? bigWidth : width;
+    return FC_GetSpanWidth(font, text, strlen(text));
+}
 
-    return bigWidth;
+const char* FC_GetMeasureASCIIName(void)
+{
+    FC_InitGlobals();
+    return fc_ascii_measurer->name;
+}
+
+Uint16 FC_GetTextWidthMeasure(FC_Font* font, FC_MeasureEnum measure, const char* text)
+{
+    if(text == NULL || font == NULL)
+        return 0;
+
+    return FC_MeasureSpan(font, measure, text, strlen(text));
 }
 
 // If width == -1, use no width limit
 FC_Rect FC_GetCharacterOffset(FC_Font* font, Uint16 position_index, int column_width, const char* formatted_text, ...)
 {
     FC_Rect result = {0, 0, 1, FC_GetLineHeight(font)};
-    FC_StringList *ls, *iter;
+    FC_LineBreak* lines;
     int num_lines = 0;
-    Uint8 done = 0;
+    int i;
 
     if(formatted_text == NULL || column_width == 0 || position_index == 0 || font == NULL)
         return result;
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
-    ls = FC_GetBufferFitToColumn(font, column_width, FC_MakeScale(1,1), 1);
-    for(iter = ls; iter != NULL;)
+    lines = FC_BreakLines(font, fc_buffer, column_width, 1, &num_lines);
+    for(i = 0; i < num_lines; ++i)
     {
-        char* line;
-        int i = 0;
-        FC_StringList* next_iter = iter->next;
+        const char* line = fc_buffer + lines[i].start;
+        const char* end = line + lines[i].length;
+        const char* c;
 
-        ++num_lines;
-        for(line = iter->value; line != NULL && *line != '\0'; line = (char*)U8_next(line))
+        for(c = line; c < end; c = U8_next(c))
         {
-            ++i;
             --position_index;
             if(position_index == 0)
             {
                 // FIXME: Doesn't handle box-wrapped newlines correctly
-                line = (char*)U8_next(line);
-                line[0] = '\0';
-                result.x = FC_GetWidth(font, "%s", iter->value);
-                done = 1;
+                result.x = FC_GetSpanWidth(font, line, U8_next(c) - line);
                 break;
             }
         }
-        if(done)
+        if(c < end)
             break;
 
+        // The trailing space of a wrapped line counts as a character too
+        if(lines[i].space && --position_index == 0)
+        {
+            result.x = FC_GetLineBreakWidth(font, fc_buffer, &lines[i]);
+            break;
+        }
+
         // Prevent line wrapping if there are no more lines
-        if(next_iter == NULL && !done)
-            result.x = FC_GetWidth(font, "%s", iter->value);
-        iter = next_iter;
+        if(i == num_lines - 1)
+            result.x = FC_GetLineBreakWidth(font, fc_buffer, &lines[i]);
     }
-    FC_StringListFree(ls);
+
+    // Lines down to the one holding the character
+    if(i < num_lines)
+        num_lines = i + 1;
 
     if(num_lines > 1)
     {
@@ -2371,26 +3456,33 @@ FC_Rect FC_GetCharacterOffset(FC_Font* font, Uint16 position_index, int column_w
 
 Uint16 FC_GetColumnHeight(FC_Font* font, Uint16 width, const char* formatted_text, ...)
 {
-    int y = 0;
-
-    FC_StringList *ls, *iter;
-
     if(font == NULL)
         return 0;
 
     if(formatted_text == NULL || width == 0)
         return font->height;
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
-    ls = FC_GetBufferFitToColumn(font, width, FC_MakeScale(1,1), 0);
-    for(iter = ls; iter != NULL; iter = iter->next)
-    {
-        y += FC_GetLineHeight(font);
-    }
-    FC_StringListFree(ls);
+    return FC_GetTextColumnHeight(font, width, fc_buffer);
+}
+
+Uint16 FC_GetTextColumnHeight(FC_Font* font, Uint16 width, const char* text)
+{
+    if(font == NULL)
+        return 0;
+
+    if(text == NULL || width == 0)
+        return font->height;
+
+    int height;
+
+    SDL_LockMutex(font->mutex);
+    height = FC_GetLayout(font, text, width)->height;
+    SDL_UnlockMutex(font->mutex);
 
-    return y;
+    return height;
 }
 
 static int FC_GetAscentFromCodepoint(FC_Font* font, Uint32 codepoint)
@@ -2429,6 +3521,7 @@ int FC_GetAscent(FC_Font* font, const char* formatted_text, ...)
     if(formatted_text == NULL)
         return font->ascent;
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     max = 0;
@@ -2460,6 +3553,7 @@ int FC_GetDescent(FC_Font* font, const char* formatted_text, ...)
     if(formatted_text == NULL)
         return font->descent;
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
     max = 0;
@@ -2531,7 +3625,9 @@ Uint8 FC_InRect(float x, float y, FC_Rect input_rect)
 // TODO: Make it work with alignment
 Uint16 FC_GetPositionFromOffset(FC_Font* font, float x, float y, int column_width, FC_AlignEnum align, const char* formatted_text, ...)
 {
-    FC_StringList *ls, *iter;
+    FC_LineBreak* lines;
+    int num_lines = 0;
+    int i;
     Uint8 done = 0;
     int height = FC_GetLineHeight(font);
     Uint16 position = 0;
@@ -2542,16 +3638,32 @@ Uint16 FC_GetPositionFromOffset(FC_Font* font, float x, float y, int column_widt
     if(formatted_text == NULL || column_width == 0 || font == NULL)
         return 0;
 
+    char* fc_buffer = FC_GetBuffer();
     FC_EXTRACT_VARARGS(fc_buffer, formatted_text);
 
-    ls = FC_GetBufferFitToColumn(font, column_width, FC_MakeScale(1,1), 1);
-    for(iter = ls; iter != NULL; iter = iter->next)
+    lines = FC_BreakLines(font, fc_buffer, column_width, 1, &num_lines);
+    for(i = 0; i < num_lines; ++i)
     {
-        char* line;
+        const char* c = fc_buffer + lines[i].start;
+        const char* end = c + lines[i].length;
+        Uint8 space = lines[i].space;
 
-        for(line = iter->value; line != NULL && *line != '\0'; line = (char*)U8_next(line))
+        while(c < end || space)
         {
-            if(FC_GetGlyphData(font, &glyph_data, FC_GetCodepointFromUTF8((const char**)&line, 0)))
+            Uint32 codepoint;
+            if(c < end)
+            {
+                codepoint = FC_GetCodepointFromUTF8(&c, 0);
+                c = U8_next(c);
+            }
+            else
+            {
+                // The trailing space of a wrapped line
+                codepoint = ' ';
+                space = 0;
+            }
+
+            if(FC_GetGlyphData(font, &glyph_data, codepoint))
             {
                 if(FC_InRect(x, y, FC_MakeRect(current_x, current_y, glyph_data.rect.w, glyph_data.rect.h)))
                 {
@@ -2571,7 +3683,6 @@ Uint16 FC_GetPositionFromOffset(FC_Font* font, float x, float y, int column_widt
         if(y < current_y)
             break;
     }
-    FC_StringListFree(ls);
 
     return position;
 }
@@ -2615,6 +3726,40 @@ void FC_SetSpacing(FC_Font* font, int LetterSpacing)
         return;
 
     font->letterSpacing = LetterSpacing;
+
+    // Cached layouts placed their glyphs with the old spacing
+    SDL_LockMutex(font->mutex);
+    FC_ClearLayoutCache(font);
+    SDL_UnlockMutex(font->mutex);
+}
+
+void FC_SetGlyphBatching(FC_Font* font, Uint8 enable)
+{
+    if(font == NULL)
+        return;
+
+    #ifdef FC_USE_GLYPH_BATCHING
+    font->batching = enable;
+    #endif
+}
+
+void FC_SetLayoutCacheBudget(FC_Font* font, unsigned int bytes)
+{
+    if(font == NULL)
+        return;
+
+    SDL_LockMutex(font->mutex);
+    font->layout_cache_budget = bytes;
+    FC_EvictLayouts(font, NULL);
+    SDL_UnlockMutex(font->mutex);
+}
+
+unsigned int FC_GetLayoutCacheSize(FC_Font* font)
+{
+    if(font == NULL)
+        return 0;
+
+    return font->layout_cache_size;
 }
 
 void FC_SetLineSpacing(FC_Font* font, int LineSpacing)
@@ -82,6 +82,12 @@ typedef enum
     FC_FILTER_LINEAR
 } FC_FilterEnum;
 
+typedef enum
+{
+    FC_MEASURE_TABLE,
+    FC_MEASURE_GLYPHS
+} FC_MeasureEnum;
+
 typedef struct FC_Scale
 {
     float x;
@@ -249,6 +255,12 @@ Uint8 FC_GetGlyphData(FC_Font* font, FC_GlyphData* result, Uint32 codepoint);
 /*! Sets the glyph data for the given codepoint.  Duplicates are not checked.  Returns a pointer to the stored data. */
 FC_GlyphData* FC_SetGlyphData(FC_Font* font, Uint32 codepoint, FC_GlyphData glyph_data);
 
+/*! Writes the font's metrics, glyph data and cache levels to 'dst'.  'source' identifies the TTF the font came from (e.g. its path, point size, file size and modification time) and is stored for FC_LoadGlyphCache to check.  Returns 0 if the cache levels could not be read back. */
+Uint8 FC_SaveGlyphCache(FC_Font* font, SDL_RWops* dst, const char* source);
+
+/*! Replaces the font's glyph cache with one written by FC_SaveGlyphCache.  The file must have been saved with the same 'source' string and the font's metrics must match; glyphs missing from the file are still rendered on demand.  Returns 0 if the file does not match the font. */
+Uint8 FC_LoadGlyphCache(FC_Font* font, SDL_RWops* src, const char* source);
+
 
 // Rendering
 
@@ -270,6 +282,16 @@ FC_Rect FC_DrawColumnScale(FC_Font* font, FC_Target* dest, float x, float y, Uin
 FC_Rect FC_DrawColumnColor(FC_Font* font, FC_Target* dest, float x, float y, Uint16 width, SDL_Color color, const char* formatted_text, ...);
 FC_Rect FC_DrawColumnEffect(FC_Font* font, FC_Target* dest, float x, float y, Uint16 width, FC_Effect effect, const char* formatted_text, ...);
 
+// Unformatted text, drawn and measured straight from the caller's string
+FC_Rect FC_DrawText(FC_Font* font, FC_Target* dest, float x, float y, FC_Effect effect, const char* text);
+FC_Rect FC_DrawBoxText(FC_Font* font, FC_Target* dest, FC_Rect box, FC_Effect effect, const char* text);
+Uint16 FC_GetTextWidth(FC_Font* font, const char* text);
+// Same width as FC_GetTextWidth(), with ASCII summed from the font's width table or looked up glyph by glyph
+Uint16 FC_GetTextWidthMeasure(FC_Font* font, FC_MeasureEnum measure, const char* text);
+// Which of the scalar, SSE2, AVX2 or NEON ASCII-run measurers this CPU got
+const char* FC_GetMeasureASCIIName(void);
+Uint16 FC_GetTextColumnHeight(FC_Font* font, Uint16 width, const char* text);
+
 
 // Getters
 
@@ -289,6 +311,8 @@ int FC_GetSpacing(FC_Font* font);
 int FC_GetLineSpacing(FC_Font* font);
 Uint16 FC_GetMaxWidth(FC_Font* font);
 SDL_Color FC_GetDefaultColor(FC_Font* font);
+// Bytes held by wrapped box and column text kept for reuse
+unsigned int FC_GetLayoutCacheSize(FC_Font* font);
 
 Uint8 FC_InRect(float x, float y, FC_Rect input_rect);
 // Given an offset (x,y) from the text draw position (the upper-left corner), returns the character position (UTF-8 index)
@@ -300,6 +324,10 @@ void FC_SetFilterMode(FC_Font* font, FC_FilterEnum filter);
 void FC_SetSpacing(FC_Font* font, int LetterSpacing);
 void FC_SetLineSpacing(FC_Font* font, int LineSpacing);
 void FC_SetDefaultColor(FC_Font* font, SDL_Color color);
+// Draws each string with one SDL_RenderGeometry() call per glyph cache texture, on by default where SDL supports it
+void FC_SetGlyphBatching(FC_Font* font, Uint8 enable);
+// Least recently drawn layouts are dropped once they hold more than this many bytes, straight away when lowered
+void FC_SetLayoutCacheBudget(FC_Font* font, unsigned int bytes);
 
 
 #ifdef __cplusplus
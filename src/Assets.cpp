@@ -0,0 +1,110 @@
+#include <cstdio>
+
+#include <sys/stat.h>
+
+#include <NFont.h>
+#include <fmt/format.h>
+
+#include "Assets.hpp"
+
+static size_t TextureBytes(SDL_Texture *texture) {
+  Uint32 format;
+  int w, h;
+  if(texture == nullptr || SDL_QueryTexture(texture, &format, nullptr, &w, &h) != 0) return 0;
+
+  return static_cast<size_t>(w) * h * SDL_BYTESPERPIXEL(format);
+}
+
+// Identifies the exact TTF a baked cache came from, so an edited or replaced font is baked again
+static std::string FontSource(const std::string &path, Uint32 pointSize) {
+  struct stat info;
+  if(stat(path.c_str(), &info) != 0) return "";
+
+  return fmt::format("{}@{} {} bytes, modified {}", path, pointSize, static_cast<long long>(info.st_size), static_cast<long long>(info.st_mtime));
+}
+
+// Baked on the first run, so later starts skip rasterizing the loading string through SDL_ttf
+static std::shared_ptr<NFont> LoadBakedFont(SDL_Renderer *renderer, const std::string &path, Uint32 pointSize, const std::string &bakedPath, const std::string &source) {
+  SDL_RWops *baked = SDL_RWFromFile(bakedPath.c_str(), "rb");
+  if(baked == nullptr) return nullptr;
+
+  auto font = std::make_shared<NFont>();
+  font->setLoadingString("");
+  bool loaded = font->load(renderer, path.c_str(), pointSize) && font->loadGlyphCache(baked, source.c_str());
+  SDL_RWclose(baked);
+
+  return loaded ? font : nullptr;
+}
+
+static void BakeFont(NFont &font, const std::string &bakedPath, const std::string &source) {
+  SDL_RWops *baked = SDL_RWFromFile(bakedPath.c_str(), "wb");
+  if(baked == nullptr) return;
+
+  bool saved = font.saveGlyphCache(baked, source.c_str());
+  SDL_RWclose(baked);
+  if(!saved) remove(bakedPath.c_str());
+}
+
+Assets::Assets(SDL2pp::Renderer &render, bool bakeFonts) : render(render) {
+  if(!bakeFonts) return;
+
+  // Baked glyphs are per user state, so they go to the preferences directory rather than next to the assets
+  char *prefPath = SDL_GetPrefPath("ldjam", "asteroid");
+  if(prefPath == nullptr) return;
+
+  glyphCacheDir = prefPath;
+  SDL_free(prefPath);
+}
+
+std::shared_ptr<SDL2pp::Texture> Assets::GetTexture(const std::string &path) {
+  auto texture = textures[path].lock();
+  if(!texture) {
+    texture = std::make_shared<SDL2pp::Texture>(render, path);
+    textures[path] = texture;
+  }
+
+  return texture;
+}
+
+std::shared_ptr<NFont> Assets::GetFont(const std::string &path, Uint32 pointSize) {
+  std::string key = fmt::format("{}@{}", path, pointSize);
+
+  auto font = fonts[key].lock();
+  if(!font) {
+    std::string source = glyphCacheDir.empty() ? "" : FontSource(path, pointSize);
+    std::string bakedPath = fmt::format("{}{}.{}.glyphs", glyphCacheDir, path.substr(path.find_last_of("/\\") + 1), pointSize);
+
+    if(!source.empty()) font = LoadBakedFont(render.Get(), path, pointSize, bakedPath, source);
+    if(!font) {
+      font = std::make_shared<NFont>(render.Get(), path.c_str(), pointSize);
+      if(!source.empty()) BakeFont(*font, bakedPath, source);
+    }
+    fonts[key] = font;
+  }
+
+  return font;
+}
+
+std::vector<Assets::Usage> Assets::GetUsage() const {
+  std::vector<Usage> usage;
+
+  for(const auto& entry : textures) {
+    auto texture = entry.second.lock();
+    if(!texture) continue;
+
+    usage.push_back(Usage{entry.first, TextureBytes(texture->Get()), texture.use_count() - 1});
+  }
+
+  for(const auto& entry : fonts) {
+    auto font = entry.second.lock();
+    if(!font) continue;
+
+    size_t bytes = 0;
+    for(int level = 0; level < font->getNumCacheLevels(); level++) {
+      bytes += TextureBytes(font->getCacheLevel(level));
+    }
+    usage.push_back(Usage{entry.first, bytes, font.use_count() - 1});
+  }
+
+  return usage;
+}
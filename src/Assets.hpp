@@ -0,0 +1,37 @@
+#ifndef _ASSETS_HPP_
+  #define _ASSETS_HPP_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+#include <SDL2pp/Renderer.hh>
+#include <SDL2pp/Texture.hh>
+
+class NFont;
+
+class Assets {
+private:
+  SDL2pp::Renderer &render;
+  std::string glyphCacheDir;
+
+  std::map<std::string, std::weak_ptr<SDL2pp::Texture>> textures;
+  std::map<std::string, std::weak_ptr<NFont>> fonts;
+public:
+  struct Usage {
+    std::string key;
+    size_t bytes;
+    long handles;
+  };
+
+  Assets(SDL2pp::Renderer &render, bool bakeFonts);
+
+  std::shared_ptr<SDL2pp::Texture> GetTexture(const std::string &path);
+  std::shared_ptr<NFont> GetFont(const std::string &path, Uint32 pointSize);
+
+  std::vector<Usage> GetUsage() const;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Camera.hpp"
+
+// std::min and std::max bind these by reference, so they need a definition before C++17
+constexpr float Camera::MIN_ZOOM;
+constexpr float Camera::MAX_ZOOM;
+
+Camera::Camera(const SDL2pp::Rect &viewport, const SDL2pp::Point &origin) : viewport(viewport), origin(origin) {
+}
+
+void Camera::Pan(const SDL2pp::Point &delta) {
+  if(delta.x == 0 && delta.y == 0) return;
+
+  panX += delta.x;
+  panY += delta.y;
+  version++;
+}
+
+void Camera::Zoom(float factor, const SDL2pp::Point &anchor) {
+  float newZoom = std::min(MAX_ZOOM, std::max(MIN_ZOOM, zoom * factor));
+  if(newZoom == zoom) return;
+
+  // Keep the map point under the anchor in place
+  float mapX = (anchor.x - origin.x - panX) / zoom;
+  float mapY = (anchor.y - origin.y - panY) / zoom;
+  panX = anchor.x - origin.x - mapX * newZoom;
+  panY = anchor.y - origin.y - mapY * newZoom;
+  zoom = newZoom;
+  version++;
+}
+
+SDL2pp::Point Camera::ToScreen(const SDL2pp::Point &point) const {
+  return SDL2pp::Point(
+    static_cast<int>(std::floor(origin.x + panX + point.x * zoom)),
+    static_cast<int>(std::floor(origin.y + panY + point.y * zoom))
+  );
+}
+
+SDL2pp::Point Camera::ToMap(const SDL2pp::Point &point) const {
+  return SDL2pp::Point(
+    static_cast<int>(std::floor((point.x - origin.x - panX) / zoom)),
+    static_cast<int>(std::floor((point.y - origin.y - panY) / zoom))
+  );
+}
+
+SDL2pp::Rect Camera::GetVisibleArea() const {
+  SDL2pp::Point topLeft = ToMap(SDL2pp::Point(viewport.x, viewport.y));
+  SDL2pp::Point bottomRight = ToMap(SDL2pp::Point(viewport.x + viewport.w, viewport.y + viewport.h));
+
+  return SDL2pp::Rect(topLeft, bottomRight - topLeft + SDL2pp::Point(1, 1));
+}
@@ -0,0 +1,32 @@
+#ifndef _CAMERA_HPP_
+  #define _CAMERA_HPP_
+
+#include <SDL2pp/Point.hh>
+#include <SDL2pp/Rect.hh>
+
+class Camera {
+private:
+  static constexpr float MIN_ZOOM = 0.25f;
+  static constexpr float MAX_ZOOM = 4.0f;
+
+  SDL2pp::Rect viewport;
+  SDL2pp::Point origin;
+  float panX = 0.0f, panY = 0.0f;
+  float zoom = 1.0f;
+  unsigned int version = 0;
+public:
+  Camera(const SDL2pp::Rect &viewport, const SDL2pp::Point &origin);
+
+  void Pan(const SDL2pp::Point &delta);
+  void Zoom(float factor, const SDL2pp::Point &anchor);
+
+  SDL2pp::Point ToScreen(const SDL2pp::Point &point) const;
+  SDL2pp::Point ToMap(const SDL2pp::Point &point) const;
+  SDL2pp::Rect GetVisibleArea() const;
+
+  const SDL2pp::Rect& GetViewport() const { return viewport; }
+  float GetZoom() const { return zoom; }
+  unsigned int GetVersion() const { return version; }
+};
+
+#endif
@@ -0,0 +1,218 @@
+#include <algorithm>
+
+#include "CommandBuffer.hpp"
+#include "Profiler.hpp"
+
+CommandBuffer::Stats CommandBuffer::frameUnsorted;
+CommandBuffer::Stats CommandBuffer::frameSorted;
+CommandBuffer::Stats CommandBuffer::lastUnsorted;
+CommandBuffer::Stats CommandBuffer::lastSorted;
+
+static Uint32 PackColor(const SDL2pp::Color &color) {
+  return (color.r << 24) | (color.g << 16) | (color.b << 8) | color.a;
+}
+
+static SDL2pp::Rect ToRect(const SDL_Rect &rect) {
+  return SDL2pp::Rect(rect.x, rect.y, rect.w, rect.h);
+}
+
+CommandBuffer::CommandBuffer(SDL2pp::Renderer &render) : render(render), batch(render) {
+}
+
+void CommandBuffer::Record(
+  int layer,
+  Type type,
+  SDL2pp::Texture *texture,
+  const SDL2pp::Color &color,
+  const SDL_Rect &source,
+  const SDL_Rect &destination,
+  int custom
+) {
+  commands.push_back(Command{
+    layer,
+    static_cast<int>(commands.size()),
+    0,
+    type,
+    texture,
+    PackColor(color),
+    source,
+    destination,
+    custom
+  });
+}
+
+void CommandBuffer::Copy(int layer, SDL2pp::Texture &texture, const SDL2pp::Rect &source, const SDL2pp::Rect &destination) {
+  Record(layer, Type::Copy, &texture, SDL2pp::Color(255, 255, 255), source, destination, -1);
+}
+
+void CommandBuffer::FillRect(int layer, const SDL2pp::Rect &rect, const SDL2pp::Color &color) {
+  Record(layer, Type::FillRect, nullptr, color, rect, rect, -1);
+}
+
+void CommandBuffer::DrawRect(int layer, const SDL2pp::Rect &rect, const SDL2pp::Color &color) {
+  Record(layer, Type::DrawRect, nullptr, color, rect, rect, -1);
+}
+
+void CommandBuffer::Custom(int layer, std::function<void()> draw) {
+  customs.push_back(draw);
+  Record(layer, Type::Custom, nullptr, SDL2pp::Color(0, 0, 0), SDL_Rect{0, 0, 0, 0}, SDL_Rect{0, 0, 0, 0}, customs.size() - 1);
+}
+
+bool CommandBuffer::SameGroup(const Command &a, const Command &b) {
+  if(a.type != b.type || a.type == Type::Custom) return false;
+  return a.type == Type::Copy ? a.texture == b.texture : a.color == b.color;
+}
+
+void CommandBuffer::Group() {
+  struct Run {
+    const Command *head;
+    SDL_Rect bounds;
+  };
+  std::vector<Run> groups;
+
+  // Painter's order holds within a layer, so a command may only join an earlier group
+  // when nothing drawn in between overlaps it. Custom draws have unknown bounds and stop the search.
+  for(auto& command : commands) {
+    int target = -1;
+    int stop = std::max(0, static_cast<int>(groups.size()) - LOOKBACK);
+    for(int g = static_cast<int>(groups.size()) - 1; g >= stop; g--) {
+      const Run &group = groups[g];
+      if(group.head->layer != command.layer || group.head->type == Type::Custom) break;
+      if(SameGroup(*group.head, command)) {
+        target = g;
+        break;
+      }
+      if(SDL_HasIntersection(&group.bounds, &command.destination)) break;
+    }
+
+    if(target < 0) {
+      command.group = groups.size();
+      groups.push_back(Run{&command, command.destination});
+    } else {
+      command.group = target;
+      SDL_UnionRect(&groups[target].bounds, &command.destination, &groups[target].bounds);
+    }
+  }
+}
+
+CommandBuffer::Stats CommandBuffer::Measure() const {
+  Stats stats;
+  stats.commands = commands.size();
+
+  const Command *previous = nullptr;
+  SDL2pp::Texture *texture = nullptr;
+  Uint32 color = 0;
+  bool colorKnown = false;
+
+  for(const auto& command : commands) {
+    if(previous != nullptr && SameGroup(*previous, command)) continue;
+    previous = &command;
+    stats.drawCalls++;
+
+    switch(command.type) {
+    case Type::Copy:
+      if(command.texture != texture) {
+        texture = command.texture;
+        stats.stateChanges++;
+      }
+
+      break;
+    case Type::FillRect:
+    case Type::DrawRect:
+      if(!colorKnown || command.color != color) {
+        color = command.color;
+        colorKnown = true;
+        stats.stateChanges++;
+      }
+
+      break;
+    case Type::Custom:
+      // Custom draws bind their own state, so whatever follows has to set it again
+      texture = nullptr;
+      colorKnown = false;
+
+      break;
+    }
+  }
+
+  return stats;
+}
+
+void CommandBuffer::Submit() {
+  if(commands.empty()) return;
+
+  PROFILE_ZONE("CommandBuffer::Submit");
+
+  Stats unsorted = Measure();
+  std::stable_sort(std::begin(commands), std::end(commands), [](const Command &a, const Command &b) {
+    return a.layer < b.layer;
+  });
+  Group();
+  std::sort(std::begin(commands), std::end(commands), [](const Command &a, const Command &b) {
+    return a.group != b.group ? a.group < b.group : a.sequence < b.sequence;
+  });
+  Stats sorted = Measure();
+
+  frameUnsorted.commands += unsorted.commands;
+  frameUnsorted.drawCalls += unsorted.drawCalls;
+  frameUnsorted.stateChanges += unsorted.stateChanges;
+  frameSorted.commands += sorted.commands;
+  frameSorted.drawCalls += sorted.drawCalls;
+  frameSorted.stateChanges += sorted.stateChanges;
+
+  SDL2pp::Color oldDrawColor = render.GetDrawColor();
+  Uint32 color = PackColor(oldDrawColor);
+
+  for(size_t first = 0; first < commands.size();) {
+    size_t last = first + 1;
+    while(last < commands.size() && SameGroup(commands[first], commands[last])) last++;
+
+    const Command &command = commands[first];
+    switch(command.type) {
+    case Type::Copy:
+      for(size_t i = first; i < last; i++) {
+        batch.Add(*commands[i].texture, ToRect(commands[i].source), ToRect(commands[i].destination));
+      }
+      batch.Flush();
+
+      break;
+    case Type::FillRect:
+    case Type::DrawRect:
+      if(command.color != color) {
+        color = command.color;
+        render.SetDrawColor(color >> 24, (color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF);
+      }
+
+      rects.clear();
+      for(size_t i = first; i < last; i++) {
+        rects.push_back(commands[i].destination);
+      }
+
+      if(command.type == Type::FillRect) {
+        SDL_RenderFillRects(render.Get(), rects.data(), rects.size());
+      } else {
+        SDL_RenderDrawRects(render.Get(), rects.data(), rects.size());
+      }
+
+      break;
+    case Type::Custom:
+      customs[command.custom]();
+      color = PackColor(render.GetDrawColor());
+
+      break;
+    }
+
+    first = last;
+  }
+
+  render.SetDrawColor(oldDrawColor);
+  commands.clear();
+  customs.clear();
+}
+
+void CommandBuffer::EndFrame() {
+  lastUnsorted = frameUnsorted;
+  lastSorted = frameSorted;
+  frameUnsorted = Stats();
+  frameSorted = Stats();
+}
@@ -0,0 +1,80 @@
+#ifndef _COMMANDBUFFER_HPP_
+  #define _COMMANDBUFFER_HPP_
+
+#include <functional>
+#include <vector>
+
+#include <SDL.h>
+#include <SDL2pp/Color.hh>
+#include <SDL2pp/Rect.hh>
+#include <SDL2pp/Renderer.hh>
+#include <SDL2pp/Texture.hh>
+
+#include "SpriteBatch.hpp"
+
+class CommandBuffer {
+public:
+  struct Stats {
+    int commands = 0;
+    int drawCalls = 0;
+    int stateChanges = 0;
+  };
+
+  // Frame-wide layers in stacking order, a presenter draws its content one layer above its frame
+  static const int MAP_LAYER = 0;
+  static const int PANEL_LAYER = 2;
+  static const int DRAG_LAYER = 4;
+  static const int MODAL_LAYER = 6;
+  static const int OVERLAY_LAYER = 8;
+private:
+  enum class Type : Uint8 {
+    Copy,
+    FillRect,
+    DrawRect,
+    Custom
+  };
+
+  // How many groups back a command may be hoisted past non-overlapping draws
+  static const int LOOKBACK = 8;
+
+  struct Command {
+    int layer;
+    int sequence;
+    int group;
+    Type type;
+    SDL2pp::Texture *texture;
+    Uint32 color;
+    SDL_Rect source;
+    SDL_Rect destination;
+    int custom;
+  };
+
+  static Stats frameUnsorted, frameSorted;
+  static Stats lastUnsorted, lastSorted;
+
+  SDL2pp::Renderer &render;
+  SpriteBatch batch;
+  std::vector<Command> commands;
+  std::vector<std::function<void()>> customs;
+  std::vector<SDL_Rect> rects;
+
+  void Record(int layer, Type type, SDL2pp::Texture *texture, const SDL2pp::Color &color, const SDL_Rect &source, const SDL_Rect &destination, int custom);
+  static bool SameGroup(const Command &a, const Command &b);
+  void Group();
+  Stats Measure() const;
+public:
+  CommandBuffer(SDL2pp::Renderer &render);
+
+  void Copy(int layer, SDL2pp::Texture &texture, const SDL2pp::Rect &source, const SDL2pp::Rect &destination);
+  void FillRect(int layer, const SDL2pp::Rect &rect, const SDL2pp::Color &color);
+  void DrawRect(int layer, const SDL2pp::Rect &rect, const SDL2pp::Color &color);
+  void Custom(int layer, std::function<void()> draw);
+
+  void Submit();
+
+  static void EndFrame();
+  static const Stats& GetUnsortedStats() { return lastUnsorted; }
+  static const Stats& GetSortedStats() { return lastSorted; }
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include <cerrno>
+#include <stdexcept>
+
+#ifdef _WIN32
+  #include <direct.h>
+#else
+  #include <sys/stat.h>
+#endif
+
+#include <SDL_image.h>
+#include <fmt/format.h>
+
+#include "FrameCapture.hpp"
+#include "Profiler.hpp"
+
+// Creates the directory and any missing parents, like mkdir -p
+static bool MakeDirectories(const std::string &path) {
+  for(size_t end = path.find_first_of("/\\", 1); ; end = path.find_first_of("/\\", end + 1)) {
+    std::string directory = path.substr(0, end);
+#ifdef _WIN32
+    int result = _mkdir(directory.c_str());
+#else
+    int result = mkdir(directory.c_str(), 0755);
+#endif
+    if(result != 0 && errno != EEXIST) return false;
+    if(end == std::string::npos) return true;
+  }
+}
+
+FrameCapture::FrameCapture(const std::string &path, Format format, int every) :
+  path(path),
+  format(format),
+  every(every > 0 ? every : 1)
+{
+  // Fail up front rather than lose every frame on the writer thread
+  std::string directory = format == Format::Raw ? path.substr(0, path.find_last_of("/\\") + 1) : path;
+  if(!directory.empty() && !MakeDirectories(directory)) {
+    throw std::runtime_error("unable to create capture directory " + directory);
+  }
+
+  if(format == Format::Raw) {
+    raw.open(path, std::ios::binary);
+    timestamps.open(path + ".txt");
+    if(!raw) throw std::runtime_error("unable to write " + path);
+  } else {
+    timestamps.open(path + "/frames.txt");
+  }
+  if(!timestamps) throw std::runtime_error("unable to write capture timestamps next to " + path);
+
+  worker = std::thread(&FrameCapture::Run, this);
+}
+
+FrameCapture::~FrameCapture() {
+  Finish();
+}
+
+void FrameCapture::Capture(SDL2pp::Renderer &render) {
+  if(presented++ % every != 0) return;
+
+  PROFILE_ZONE("FrameCapture::Capture");
+
+  if(pool.empty()) {
+    SDL2pp::Point size = render.GetOutputSize();
+    width = size.x;
+    height = size.y;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pool.resize(POOL_SIZE);
+    for(int i = 0; i < POOL_SIZE; i++) {
+      pool[i].pixels.resize(width * height * 4);
+      freeFrames.push_back(i);
+    }
+  }
+
+  int slot;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    // The encoder is behind and every buffer is queued, so drop rather than stall the frame
+    if(freeFrames.empty()) {
+      dropped++;
+      return;
+    }
+    slot = freeFrames.back();
+    freeFrames.pop_back();
+  }
+
+  Frame &frame = pool[slot];
+  render.ReadPixels(SDL2pp::NullOpt, SDL_PIXELFORMAT_RGBA32, frame.pixels.data(), width * 4);
+  frame.index = captured++;
+  frame.timestamp = SDL_GetTicks();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.push_back(slot);
+  }
+  ready.notify_one();
+}
+
+void FrameCapture::Run() {
+  while(true) {
+    int slot;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      ready.wait(lock, [this] { return stopping || !pending.empty(); });
+      if(pending.empty()) return;
+
+      slot = pending.front();
+      pending.pop_front();
+    }
+
+    bool encoded = Encode(pool[slot]);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    freeFrames.push_back(slot);
+    if(encoded) {
+      written++;
+    } else {
+      failed++;
+    }
+  }
+}
+
+bool FrameCapture::Encode(const Frame &frame) {
+  if(format == Format::Raw) {
+    raw.write(reinterpret_cast<const char*>(frame.pixels.data()), frame.pixels.size());
+    if(!raw) {
+      SDL_Log("FrameCapture: unable to write frame %d to %s", frame.index, path.c_str());
+      raw.clear();
+      return false;
+    }
+  } else {
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormatFrom(
+      const_cast<Uint8*>(frame.pixels.data()),
+      width,
+      height,
+      32,
+      width * 4,
+      SDL_PIXELFORMAT_RGBA32
+    );
+    std::string file = fmt::format("{}/frame_{:06d}.png", path, frame.index);
+    bool saved = surface != nullptr && IMG_SavePNG(surface, file.c_str()) == 0;
+    if(!saved) {
+      SDL_Log("FrameCapture: unable to write %s: %s", file.c_str(), SDL_GetError());
+    }
+    SDL_FreeSurface(surface);
+    if(!saved) return false;
+  }
+
+  timestamps << frame.index << " " << frame.timestamp << "\n";
+  return true;
+}
+
+void FrameCapture::Finish() {
+  if(!worker.joinable()) return;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  ready.notify_one();
+  worker.join();
+
+  raw.close();
+  timestamps.close();
+}
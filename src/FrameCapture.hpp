@@ -0,0 +1,69 @@
+#ifndef _FRAMECAPTURE_HPP_
+  #define _FRAMECAPTURE_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SDL.h>
+#include <SDL2pp/Point.hh>
+#include <SDL2pp/Renderer.hh>
+
+class FrameCapture {
+public:
+  enum class Format {
+    Png,
+    Raw
+  };
+private:
+  static const int POOL_SIZE = 4;
+
+  struct Frame {
+    std::vector<Uint8> pixels;
+    int index;
+    Uint32 timestamp;
+  };
+
+  std::string path;
+  Format format;
+  int every;
+
+  int width = 0, height = 0;
+  int presented = 0;
+  int captured = 0;
+  int written = 0;
+  int dropped = 0;
+  int failed = 0;
+
+  std::vector<Frame> pool;
+  std::vector<int> freeFrames;
+  std::deque<int> pending;
+  std::mutex mutex;
+  std::condition_variable ready;
+  bool stopping = false;
+  std::thread worker;
+
+  std::ofstream raw;
+  std::ofstream timestamps;
+
+  void Run();
+  bool Encode(const Frame &frame);
+public:
+  FrameCapture(const std::string &path, Format format, int every);
+  ~FrameCapture();
+
+  void Capture(SDL2pp::Renderer &render);
+  void Finish();
+
+  int GetCaptured() const { return captured; }
+  int GetWritten() const { return written; }
+  int GetDropped() const { return dropped; }
+  int GetFailed() const { return failed; }
+  SDL2pp::Point GetSize() const { return SDL2pp::Point(width, height); }
+};
+
+#endif
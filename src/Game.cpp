@@ -1,23 +1,54 @@
+#include <SDL2pp/Exception.hh>
+
+#include "CommandBuffer.hpp"
 #include "Game.hpp"
+#include "Profiler.hpp"
+
+bool Game::headless = false;
 
-Game Game::instance;
+static SDL_Renderer* CreateRenderer(SDL2pp::Window *window, SDL2pp::Surface *canvas) {
+  if(canvas != nullptr) {
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(canvas->Get());
+    if(renderer == nullptr) throw SDL2pp::Exception("SDL_CreateSoftwareRenderer");
+    return renderer;
+  }
 
+  SDL_Renderer *renderer = SDL_CreateRenderer(
+    window->Get(),
+    -1,
+    SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE
+  );
+  if(renderer == nullptr) throw SDL2pp::Exception("SDL_CreateRenderer");
+  return renderer;
+}
+
+static SDL_Surface* CreateCanvas(int width, int height) {
+  SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+  if(surface == nullptr) throw SDL2pp::Exception("SDL_CreateRGBSurfaceWithFormat");
+  return surface;
+}
+
+// Created on first use, so SetHeadless can still pick the renderer
 Game* Game::Instance() {
-  return &Game::instance;
+  static Game instance;
+  return &instance;
 }
 
 Game::Game() :
-  sdl(SDL_INIT_VIDEO),
+  sdl(headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO),
   image(IMG_INIT_PNG),
-  window(
+  window(headless ? nullptr : new SDL2pp::Window(
     "Asteroid",
     SDL_WINDOWPOS_CENTERED,
     SDL_WINDOWPOS_CENTERED,
-    1000,
-    700,
+    WIDTH,
+    HEIGHT,
     SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN
-  ),
-  render(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC)
+  )),
+  canvas(headless ? new SDL2pp::Surface(CreateCanvas(WIDTH, HEIGHT)) : nullptr),
+  render(CreateRenderer(window.get(), canvas.get())),
+  assets(render, !headless),
+  commands(render)
 {
   render.SetDrawColor(140, 62, 173);
   lastTime = SDL_GetTicks();
@@ -26,49 +57,142 @@ Game::Game() :
 int Game::Loop() {
   while(running) {
     Step();
-    SDL_Delay(1);
+
+    // Playback runs on recorded time, as fast as the renderer allows
+    if(replay != nullptr && replay->IsPlaying()) continue;
+
+    if(idleWait && IsIdle()) {
+      // Nothing advances until the player acts, so sleep until an event arrives
+      SDL_WaitEventTimeout(nullptr, IDLE_TIMEOUT);
+    } else {
+      SDL_Delay(1);
+    }
   }
 
   return EXIT_SUCCESS;
 }
 
 void Game::Step() {
-  auto timeNow = SDL_GetTicks();
-  auto elapsed = timeNow - lastTime;
-  lastTime = timeNow;
+  {
+    PROFILE_ZONE("Game::Step");
+
+    auto timeNow = SDL_GetTicks();
+    Uint32 elapsed = timeNow - lastTime;
+    lastTime = timeNow;
+
+    if(replay != nullptr && replay->IsPlaying() && !replay->PlayFrame(&input, elapsed)) {
+      running = false;
+      return;
+    }
+
+    Interact();
+    if(replay != nullptr && replay->IsRecording()) {
+      replay->RecordFrame(elapsed, input.GetFrameEvents());
+    }
 
-  Interact();
-  Update(elapsed);
+    Update(elapsed);
+    Render();
+  }
+
+  Profiler::Instance()->EndFrame();
+}
+
+void Game::Redraw() {
+  forceRedraw = true;
   Render();
 }
 
 void Game::Interact() {
+  PROFILE_ZONE("Game::Interact");
+
   SDL_Event event;
   while(SDL_PollEvent(&event)) {
     if(event.type == SDL_QUIT) {
       running = false;
       break;
     }
+
+    if(event.type == SDL_WINDOWEVENT) {
+      forceRedraw = true;
+    }
+
+    if(event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+      targetsGeneration++;
+      forceRedraw = true;
+    }
+
+    if(replay == nullptr || !replay->IsPlaying()) {
+      input.ReceiveEvent(event);
+    }
   }
 
   input.Update();
   for(Presenter *presenter : presenters) {
+    PROFILE_ZONE(presenter->GetInteractZone());
     presenter->Interact(&input);
   }
+
+  // Every event starts a latency sample once presenters have seen it, it ends on the next present
+  if(replay == nullptr || !replay->IsPlaying()) {
+    latency.Processed(input.GetFrameEvents());
+  }
 }
 
 void Game::Update(float elapsed) {
+  PROFILE_ZONE("Game::Update");
+
   for(Object *object : objects) {
     object->Update(elapsed);
   }
 }
 
+bool Game::IsIdle() {
+  if(objects.empty()) return false;
+
+  for(Object *object : objects) {
+    if(!object->IsIdle()) return false;
+  }
+
+  for(Presenter *presenter : presenters) {
+    if(presenter->IsAnimating()) return false;
+  }
+
+  return true;
+}
+
+bool Game::NeedsRedraw() {
+  if(!damageTracking || forceRedraw) return true;
+
+  for(Presenter *presenter : presenters) {
+    if(presenter->IsDirty()) return true;
+  }
+
+  return false;
+}
+
 void Game::Render() {
+  if(!NeedsRedraw()) return;
+  forceRedraw = false;
+
+  PROFILE_ZONE("Game::Render");
+
   render.Clear();
   for(Presenter *presenter : presenters) {
+    PROFILE_ZONE(presenter->GetRenderZone());
     presenter->Render();
   }
+
+  // Presenters only record, the whole frame is sorted and drawn in one pass
+  commands.Submit();
+
+  if(capture != nullptr) {
+    capture->Capture(render);
+  }
+
+  PROFILE_ZONE("Game::Present");
   render.Present();
+  latency.Presented();
+  CommandBuffer::EndFrame();
 }
 
 void Game::AddObject(Object *object) {
@@ -88,6 +212,7 @@ void Game::RemoveObject(Object *object) {
 
 void Game::AddPresenter(Presenter *presenter) {
   presenters.push_back(presenter);
+  forceRedraw = true;
 }
 
 void Game::RemovePresenter(Presenter *presenter) {
@@ -99,4 +224,5 @@ void Game::RemovePresenter(Presenter *presenter) {
     ),
     std::end(presenters)
   );
+  forceRedraw = true;
 }
@@ -1,44 +1,68 @@
 #ifndef _GAME_HPP_
   #define _GAME_HPP_
 
+#include <memory>
 #include <vector>
 
 #include <SDL.h>
 #include <SDL_image.h>
 #include <SDL2pp/SDL.hh>
 #include <SDL2pp/SDLImage.hh>
+#include <SDL2pp/Surface.hh>
 #include <SDL2pp/Window.hh>
 #include <SDL2pp/Renderer.hh>
 
+#include "Assets.hpp"
+#include "CommandBuffer.hpp"
+#include "FrameCapture.hpp"
 #include "Input.hpp"
+#include "Latency.hpp"
 #include "Object.hpp"
 #include "Presenter.hpp"
+#include "Replay.hpp"
 
 class Game {
 private:
-  static Game instance;
+  static bool headless;
+  static const int WIDTH = 1000;
+  static const int HEIGHT = 700;
+  static const int IDLE_TIMEOUT = 500;
 
   SDL2pp::SDL sdl;
   SDL2pp::SDLImage image;
-  SDL2pp::Window window;
+  std::unique_ptr<SDL2pp::Window> window;
+  std::unique_ptr<SDL2pp::Surface> canvas;
   SDL2pp::Renderer render;
+  Assets assets;
+  CommandBuffer commands;
 
   Uint32 lastTime = 0;
   bool running = true;
+  bool damageTracking = false;
+  bool idleWait = true;
+  bool forceRedraw = true;
+  unsigned int targetsGeneration = 0;
   std::vector<Object*> objects;
   std::vector<Presenter*> presenters;
 
   Input input;
+  Latency latency;
+  Replay *replay = nullptr;
+  FrameCapture *capture = nullptr;
 
   Game();
   void Interact();
   void Update(float elapsed);
   void Render();
+  bool NeedsRedraw();
+  bool IsIdle();
 public:
   static Game* Instance();
+  static void SetHeadless(bool value) { headless = value; }
 
   int Loop();
   void Step();
+  void Redraw();
 
   void AddObject(Object *object);
   void RemoveObject(Object *object);
@@ -46,7 +70,17 @@ public:
   void AddPresenter(Presenter *presenter);
   void RemovePresenter(Presenter *presenter);
 
+  void SetDamageTracking(bool enabled) { damageTracking = enabled; forceRedraw = true; }
+  void SetIdleWait(bool enabled) { idleWait = enabled; }
+  void SetReplay(Replay *value) { replay = value; }
+  void SetCapture(FrameCapture *value) { capture = value; }
+
   SDL2pp::Renderer& GetRender() { return render; }
+  SDL2pp::Surface* GetCanvas() { return canvas.get(); }
+  Assets& GetAssets() { return assets; }
+  CommandBuffer& GetCommands() { return commands; }
+  unsigned int GetTargetsGeneration() const { return targetsGeneration; }
+  const Latency& GetLatency() const { return latency; }
 };
 
 #endif
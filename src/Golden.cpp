@@ -0,0 +1,47 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include <SDL_image.h>
+
+#include "Golden.hpp"
+
+bool Golden::Save(SDL_Surface *frame, const std::string &path) {
+  return IMG_SavePNG(frame, path.c_str()) == 0;
+}
+
+bool Golden::Compare(SDL_Surface *frame, const std::string &path, int tolerance, Difference &difference) {
+  SDL_Surface *loaded = IMG_Load(path.c_str());
+  if(loaded == nullptr) return false;
+
+  SDL_Surface *golden = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+  SDL_Surface *actual = SDL_ConvertSurfaceFormat(frame, SDL_PIXELFORMAT_RGBA32, 0);
+  SDL_FreeSurface(loaded);
+
+  bool comparable = golden != nullptr && actual != nullptr && golden->w == actual->w && golden->h == actual->h;
+  if(comparable) {
+    difference = Difference();
+
+    SDL_LockSurface(golden);
+    SDL_LockSurface(actual);
+    for(int y = 0; y < actual->h; y++) {
+      const Uint8 *goldenRow = static_cast<const Uint8*>(golden->pixels) + y * golden->pitch;
+      const Uint8 *actualRow = static_cast<const Uint8*>(actual->pixels) + y * actual->pitch;
+
+      for(int x = 0; x < actual->w * 4; x += 4) {
+        int delta = 0;
+        for(int channel = 0; channel < 4; channel++) {
+          delta = std::max(delta, std::abs(goldenRow[x + channel] - actualRow[x + channel]));
+        }
+
+        difference.maxDelta = std::max(difference.maxDelta, delta);
+        if(delta > tolerance) difference.pixels++;
+      }
+    }
+    SDL_UnlockSurface(actual);
+    SDL_UnlockSurface(golden);
+  }
+
+  SDL_FreeSurface(actual);
+  SDL_FreeSurface(golden);
+  return comparable;
+}
@@ -0,0 +1,19 @@
+#ifndef _GOLDEN_HPP_
+  #define _GOLDEN_HPP_
+
+#include <string>
+
+#include <SDL.h>
+
+class Golden {
+public:
+  struct Difference {
+    int pixels = 0;
+    int maxDelta = 0;
+  };
+
+  static bool Save(SDL_Surface *frame, const std::string &path);
+  static bool Compare(SDL_Surface *frame, const std::string &path, int tolerance, Difference &difference);
+};
+
+#endif
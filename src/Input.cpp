@@ -1,6 +1,108 @@
 #include "Input.hpp"
 
+void Input::ReceiveEvent(const SDL_Event &event) {
+  InputEvent input;
+  input.timestamp = event.common.timestamp;
+
+  switch(event.type) {
+  case SDL_KEYDOWN:
+  case SDL_KEYUP:
+    if(event.key.repeat) return;
+
+    input.type = event.type == SDL_KEYDOWN ? InputEvent::Type::KeyDown : InputEvent::Type::KeyUp;
+    input.code = event.key.keysym.scancode;
+
+    break;
+  case SDL_MOUSEBUTTONDOWN:
+  case SDL_MOUSEBUTTONUP:
+    input.type = event.type == SDL_MOUSEBUTTONDOWN ? InputEvent::Type::ButtonDown : InputEvent::Type::ButtonUp;
+    input.code = event.button.button;
+    input.x = event.button.x;
+    input.y = event.button.y;
+
+    break;
+  case SDL_MOUSEMOTION:
+    input.type = InputEvent::Type::Motion;
+    input.x = event.motion.x;
+    input.y = event.motion.y;
+
+    break;
+  case SDL_MOUSEWHEEL:
+    input.type = InputEvent::Type::Wheel;
+    input.x = event.wheel.x;
+    input.y = event.wheel.y;
+    if(event.wheel.direction == SDL_MOUSEWHEEL_FLIPPED) {
+      input.x = -input.x;
+      input.y = -input.y;
+    }
+
+    break;
+  default:
+    return;
+  }
+
+  PushEvent(input);
+}
+
+void Input::PushEvent(const InputEvent &event) {
+  // Only the latest position of a run of motion matters
+  if(event.type == InputEvent::Type::Motion && queueCount > 0) {
+    InputEvent &last = QueueAt(queueCount - 1);
+    if(last.type == InputEvent::Type::Motion) {
+      last = event;
+      return;
+    }
+  }
+
+  // A full queue gives up motion first, presses and releases are never lost
+  if(queueCount == queue.size() && !DropMotion()) {
+    if(event.type == InputEvent::Type::Motion) {
+      droppedEvents++;
+      return;
+    }
+    GrowQueue();
+  }
+
+  QueueAt(queueCount) = event;
+  queueCount++;
+}
+
+bool Input::DropMotion() {
+  for(size_t i = 0; i < queueCount; i++) {
+    if(QueueAt(i).type != InputEvent::Type::Motion) continue;
+
+    for(size_t j = i + 1; j < queueCount; j++) {
+      QueueAt(j - 1) = QueueAt(j);
+    }
+    queueCount--;
+    droppedEvents++;
+    return true;
+  }
+
+  return false;
+}
+
+void Input::GrowQueue() {
+  std::vector<InputEvent> grown(queue.size() * 2);
+  for(size_t i = 0; i < queueCount; i++) {
+    grown[i] = QueueAt(i);
+  }
+
+  queue.swap(grown);
+  queueHead = 0;
+}
+
 void Input::Update() {
   mouseInput.Update();
   keyboardInput.Update();
+
+  frameEvents.clear();
+  for(; queueCount > 0; queueCount--) {
+    const InputEvent &event = queue[queueHead];
+    queueHead = (queueHead + 1) % queue.size();
+
+    mouseInput.ReceiveEvent(event);
+    keyboardInput.ReceiveEvent(event);
+    frameEvents.push_back(event);
+  }
 }
@@ -1,16 +1,40 @@
 #ifndef _INPUT_HPP_
   #define _INPUT_HPP_
 
+#include <vector>
+
+#include <SDL.h>
+
+#include "InputEvent.hpp"
 #include "MouseInput.hpp"
 #include "KeyboardInput.hpp"
 
 class Input {
 private:
+  static const size_t QUEUE_SIZE = 256;
+
+  // Ring buffer, only grows when it is full of events that can't be dropped
+  std::vector<InputEvent> queue = std::vector<InputEvent>(QUEUE_SIZE);
+  size_t queueHead = 0;
+  size_t queueCount = 0;
+  unsigned int droppedEvents = 0;
+
+  std::vector<InputEvent> frameEvents;
+
   MouseInput mouseInput;
   KeyboardInput keyboardInput;
+
+  InputEvent& QueueAt(size_t index) { return queue[(queueHead + index) % queue.size()]; }
+  bool DropMotion();
+  void GrowQueue();
 public:
+  void ReceiveEvent(const SDL_Event &event);
+  void PushEvent(const InputEvent &event);
   void Update();
 
+  const std::vector<InputEvent>& GetFrameEvents() const { return frameEvents; }
+  unsigned int GetDroppedEvents() const { return droppedEvents; }
+
   MouseInput* Mouse() { return &mouseInput; }
   KeyboardInput* Keyboard() { return &keyboardInput; }
 };
@@ -0,0 +1,24 @@
+#ifndef _INPUTEVENT_HPP_
+  #define _INPUTEVENT_HPP_
+
+#include <SDL.h>
+
+struct InputEvent {
+  enum class Type : Uint8 {
+    Null,
+    KeyDown,
+    KeyUp,
+    ButtonDown,
+    ButtonUp,
+    Motion,
+    Wheel
+  };
+
+  Type type = Type::Null;
+  Uint32 timestamp = 0;
+  Sint32 code = 0;
+  Sint32 x = 0;
+  Sint32 y = 0;
+};
+
+#endif
@@ -1,23 +1,42 @@
 #include "KeyboardInput.hpp"
 
-KeyboardInput::KeyboardInput() {
-  memset(previousInput, 0, sizeof(Uint8) * SDL_NUM_SCANCODES);
-  memset(currentInput, 0, sizeof(Uint8) * SDL_NUM_SCANCODES);
+void KeyboardInput::Update() {
+  if(!changed) return;
+
+  triggered.reset();
+  released.reset();
+  changed = false;
 }
 
-void KeyboardInput::Update() {
-  memcpy(previousInput, currentInput, sizeof(Uint8) * SDL_NUM_SCANCODES);
-  memcpy(currentInput, SDL_GetKeyboardState(nullptr), sizeof(Uint8) * SDL_NUM_SCANCODES);
+void KeyboardInput::ReceiveEvent(const InputEvent &event) {
+  if(event.code < 0 || event.code >= SDL_NUM_SCANCODES) return;
+
+  switch(event.type) {
+  case InputEvent::Type::KeyDown:
+    pressed.set(event.code);
+    triggered.set(event.code);
+    changed = true;
+
+    break;
+  case InputEvent::Type::KeyUp:
+    pressed.reset(event.code);
+    released.set(event.code);
+    changed = true;
+
+    break;
+  default:
+    break;
+  }
 }
 
 bool KeyboardInput::KeyTriggered(const SDL_Scancode key) const {
-  return (currentInput[key] == 1 && previousInput[key] == 0);
+  return triggered.test(key);
 }
 
 bool KeyboardInput::KeyPressed(const SDL_Scancode key) const {
-  return (currentInput[key] == 1);
+  return pressed.test(key);
 }
 
 bool KeyboardInput::KeyReleased(const SDL_Scancode key) const {
-  return (currentInput[key] == 0 && previousInput[key] == 1);
+  return released.test(key);
 }
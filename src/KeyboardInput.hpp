@@ -1,16 +1,21 @@
 #ifndef _KEYBOARDINPUT_HPP_
   #define _KEYBOARDINPUT_HPP_
 
+#include <bitset>
+
 #include <SDL.h>
 
+#include "InputEvent.hpp"
+
 class KeyboardInput {
 private:
-  Uint8 previousInput[SDL_NUM_SCANCODES];
-  Uint8 currentInput[SDL_NUM_SCANCODES];
+  std::bitset<SDL_NUM_SCANCODES> pressed;
+  std::bitset<SDL_NUM_SCANCODES> triggered;
+  std::bitset<SDL_NUM_SCANCODES> released;
+  bool changed = false;
 public:
-  KeyboardInput();
-
   void Update();
+  void ReceiveEvent(const InputEvent &event);
 
   bool KeyTriggered(const SDL_Scancode key) const;
   bool KeyPressed(const SDL_Scancode key) const;
@@ -0,0 +1,106 @@
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include "Latency.hpp"
+
+float LatencyHistogram::GetBucketLimit(int bucket) {
+  // 1, 2, 4 ... 256 ms, the last bucket is open-ended
+  return bucket < BUCKETS - 1 ? static_cast<float>(1 << bucket) : -1.0f;
+}
+
+void LatencyHistogram::Add(float ms) {
+  int bucket = 0;
+  while(bucket < BUCKETS - 1 && ms > GetBucketLimit(bucket)) {
+    bucket++;
+  }
+
+  counts[bucket]++;
+  total++;
+  sum += ms;
+  max = std::max(max, ms);
+}
+
+float LatencyHistogram::GetPercentile(float p) const {
+  if(total == 0) return 0.0f;
+
+  // Interpolated within the bucket, assuming its samples are spread evenly
+  float target = p * total;
+  unsigned int seen = 0;
+  for(int bucket = 0; bucket < BUCKETS; bucket++) {
+    if(counts[bucket] == 0 || seen + counts[bucket] < target) {
+      seen += counts[bucket];
+      continue;
+    }
+
+    float lower = bucket > 0 ? GetBucketLimit(bucket - 1) : 0.0f;
+    float upper = bucket < BUCKETS - 1 ? std::min(GetBucketLimit(bucket), max) : max;
+    return lower + (upper - lower) * (target - seen) / counts[bucket];
+  }
+
+  return max;
+}
+
+std::string LatencyHistogram::ToJson() const {
+  std::string buckets;
+  for(int bucket = 0; bucket < BUCKETS; bucket++) {
+    buckets.append(fmt::format(
+      "{}{{\"le_ms\":{},\"count\":{}}}",
+      bucket == 0 ? "" : ",",
+      bucket < BUCKETS - 1 ? fmt::format("{}", GetBucketLimit(bucket)) : "null",
+      counts[bucket]
+    ));
+  }
+
+  return fmt::format(
+    "{{\"samples\":{},\"average_ms\":{:.3f},\"p50_ms\":{},\"p95_ms\":{},\"p99_ms\":{},\"max_ms\":{},\"buckets\":[{}]}}",
+    total,
+    GetAverage(),
+    GetPercentile(0.50f),
+    GetPercentile(0.95f),
+    GetPercentile(0.99f),
+    max,
+    buckets
+  );
+}
+
+Latency::Latency() {
+  frequency = SDL_GetPerformanceFrequency();
+}
+
+void Latency::Processed(const std::vector<InputEvent> &events) {
+  if(events.empty()) return;
+
+  // SDL stamps events in milliseconds, so only the wait before polling is that coarse
+  Uint64 now = SDL_GetPerformanceCounter();
+  Uint32 ticks = SDL_GetTicks();
+  if(pending.empty()) processedTime = now;
+
+  for(const auto& event : events) {
+    Uint32 waited = ticks - event.timestamp;
+    Uint64 inputTime = now - std::min<Uint64>(now, waited * frequency / 1000);
+    pending.push_back(inputTime);
+    queue.Add(ToMs(now - inputTime));
+  }
+}
+
+void Latency::Presented() {
+  if(pending.empty()) return;
+
+  Uint64 now = SDL_GetPerformanceCounter();
+  for(Uint64 inputTime : pending) {
+    endToEnd.Add(ToMs(now - inputTime));
+  }
+  present.Add(ToMs(now - processedTime));
+
+  pending.clear();
+}
+
+std::string Latency::ToJson() const {
+  return fmt::format(
+    "{{\"input_to_present\":{},\"input_to_processed\":{},\"processed_to_present\":{},\"percentiles\":\"interpolated within buckets\"}}",
+    endToEnd.ToJson(),
+    queue.ToJson(),
+    present.ToJson()
+  );
+}
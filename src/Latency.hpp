@@ -0,0 +1,58 @@
+#ifndef _LATENCY_HPP_
+  #define _LATENCY_HPP_
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+#include "InputEvent.hpp"
+
+class LatencyHistogram {
+public:
+  static const int BUCKETS = 10;
+private:
+  std::array<unsigned int, BUCKETS> counts = {};
+  unsigned int total = 0;
+  double sum = 0.0;
+  float max = 0.0f;
+public:
+  static float GetBucketLimit(int bucket);
+
+  void Add(float ms);
+
+  unsigned int GetCount(int bucket) const { return counts[bucket]; }
+  unsigned int GetTotal() const { return total; }
+  float GetAverage() const { return total > 0 ? sum / total : 0.0f; }
+  float GetMax() const { return max; }
+  float GetPercentile(float p) const;
+
+  std::string ToJson() const;
+};
+
+class Latency {
+private:
+  Uint64 frequency = 1;
+  std::vector<Uint64> pending;
+  Uint64 processedTime = 0;
+
+  LatencyHistogram endToEnd;
+  LatencyHistogram queue;
+  LatencyHistogram present;
+
+  float ToMs(Uint64 ticks) const { return ticks * 1000.0 / frequency; }
+public:
+  Latency();
+
+  void Processed(const std::vector<InputEvent> &events);
+  void Presented();
+
+  const LatencyHistogram& GetEndToEnd() const { return endToEnd; }
+  const LatencyHistogram& GetQueue() const { return queue; }
+  const LatencyHistogram& GetPresent() const { return present; }
+
+  std::string ToJson() const;
+};
+
+#endif
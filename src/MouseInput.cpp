@@ -3,20 +3,41 @@
 void MouseInput::Update() {
   previousX = currentX;
   previousY = currentY;
-  previousMouseState = currentMouseState;
+
+  triggeredButtons = 0;
+  releasedButtons = 0;
 
   wheelX = 0;
   wheelY = 0;
-
-  currentMouseState = SDL_GetMouseState(&currentX, &currentY);
 }
 
-void MouseInput::ReceiveEvent(const SDL_Event &event) {
+void MouseInput::ReceiveEvent(const InputEvent &event) {
   switch(event.type) {
-  case SDL_MOUSEWHEEL:
-    wheelX = event.wheel.x;
-    wheelY = event.wheel.y;
+  case InputEvent::Type::Motion:
+    currentX = event.x;
+    currentY = event.y;
 
+    break;
+  case InputEvent::Type::ButtonDown:
+    currentX = event.x;
+    currentY = event.y;
+    pressedButtons |= SDL_BUTTON(event.code);
+    triggeredButtons |= SDL_BUTTON(event.code);
+
+    break;
+  case InputEvent::Type::ButtonUp:
+    currentX = event.x;
+    currentY = event.y;
+    pressedButtons &= ~SDL_BUTTON(event.code);
+    releasedButtons |= SDL_BUTTON(event.code);
+
+    break;
+  case InputEvent::Type::Wheel:
+    wheelX += event.x;
+    wheelY += event.y;
+
+    break;
+  default:
     break;
   }
 }
@@ -38,15 +59,13 @@ int MouseInput::GetWheelY() const {
 }
 
 bool MouseInput::ButtonTriggered(const Uint32 button) const {
-  return ((SDL_BUTTON(button) & currentMouseState) != 0) &&
-         ((SDL_BUTTON(button) & previousMouseState) == 0);
+  return (SDL_BUTTON(button) & triggeredButtons) != 0;
 }
 
 bool MouseInput::ButtonPressed(const Uint32 button) const {
-  return (SDL_BUTTON(button) & currentMouseState) != 0;
+  return (SDL_BUTTON(button) & pressedButtons) != 0;
 }
 
 bool MouseInput::ButtonReleased(const Uint32 button) const {
-  return ((SDL_BUTTON(button) & currentMouseState) == 0) &&
-         ((SDL_BUTTON(button) & previousMouseState) != 0);
+  return (SDL_BUTTON(button) & releasedButtons) != 0;
 }
@@ -7,14 +7,16 @@
 
 #include <SDL2pp/Point.hh>
 
+#include "InputEvent.hpp"
+
 class MouseInput {
 private:
-  int currentX, currentY, previousX, previousY;
-  Uint32 currentMouseState, previousMouseState;
-  Sint32 wheelX, wheelY;
+  int currentX = 0, currentY = 0, previousX = 0, previousY = 0;
+  Uint32 pressedButtons = 0, triggeredButtons = 0, releasedButtons = 0;
+  Sint32 wheelX = 0, wheelY = 0;
 public:
   void Update();
-  void ReceiveEvent(const SDL_Event &event);
+  void ReceiveEvent(const InputEvent &event);
 
   SDL2pp::Point GetPosition() const;
   SDL2pp::Point GetDifference() const;
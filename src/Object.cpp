@@ -11,3 +11,7 @@ Object::~Object() {
 
 void Object::Update(float elapsed) {
 }
+
+bool Object::IsIdle() const {
+  return false;
+}
@@ -8,6 +8,7 @@ public:
   ~Object();
 
   virtual void Update(float elapsed);
+  virtual bool IsIdle() const;
 };
 
 #endif
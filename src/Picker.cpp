@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include <SDL.h>
+#include <SDL2pp/Surface.hh>
+
+#include "LocalCoordinates.hpp"
+#include "Picker.hpp"
+
+Picker::Picker(World *world, Camera *camera, const std::string &spritesPath) : world(world), camera(camera) {
+  SDL2pp::Surface sprites = SDL2pp::Surface(spritesPath).Convert(SDL_PIXELFORMAT_RGBA32);
+  SDL_Surface *surface = sprites.Get();
+
+  SDL_LockSurface(surface);
+  for(const auto& tile : Tile::Tiles) {
+    auto &mask = masks[tile.first];
+    const SDL2pp::Rect &source = tile.second;
+
+    for(int y = 0; y < source.h && y < SPRITE_SIZE; y++) {
+      const Uint8 *pixels = static_cast<const Uint8*>(surface->pixels) + (source.y + y) * surface->pitch;
+      for(int x = 0; x < source.w && x < SPRITE_SIZE; x++) {
+        mask[y * SPRITE_SIZE + x] = pixels[(source.x + x) * 4 + 3] > 127;
+      }
+    }
+  }
+  SDL_UnlockSurface(surface);
+}
+
+bool Picker::HitTest(int row, int col, const SDL2pp::Point &point) const {
+  int size = World::GetSize();
+  if(row < 0 || col < 0 || row >= size || col >= size) return false;
+
+  SDL2pp::Point local = point - LocalCoordinates::Isometric(SDL2pp::Point(row * 32, col * 32));
+  if(local.x < 0 || local.y < 0 || local.x >= SPRITE_SIZE || local.y >= SPRITE_SIZE) return false;
+
+  auto found = masks.find(world->GetFoundation()[row][col]);
+  return found != std::end(masks) && found->second[local.y * SPRITE_SIZE + local.x];
+}
+
+bool Picker::Pick(const SDL2pp::Point &position, SDL2pp::Point &tile) const {
+  if(!camera->GetViewport().Contains(position)) return false;
+
+  SDL2pp::Point point = camera->ToMap(position);
+
+  // A sprite anchored at (u * 32, v * 16) covers [u * 32, u * 32 + 64) x [v * 16, v * 16 + 64),
+  // so only two columns and four rows of anchors can contain the point
+  int u = static_cast<int>(std::floor(point.x / 32.0f));
+  int v = static_cast<int>(std::floor(point.y / 16.0f));
+
+  std::array<SDL2pp::Point, 4> candidates;
+  int count = 0;
+  for(int dv = 0; dv < 4; dv++) {
+    for(int du = 0; du < 2; du++) {
+      int anchorU = u - du, anchorV = v - dv;
+      if((anchorU + anchorV) % 2 != 0) continue;
+
+      // Undo the isometric projection, anchorU = row - col and anchorV = row + col
+      candidates[count++] = SDL2pp::Point((anchorU + anchorV) / 2, (anchorV - anchorU) / 2);
+    }
+  }
+
+  // SpriteLayer draws by depth (row + col), ties in row-major order, so test the last drawn sprite first
+  std::sort(std::begin(candidates), std::begin(candidates) + count, [](const SDL2pp::Point &a, const SDL2pp::Point &b) {
+    int depthA = a.x + a.y, depthB = b.x + b.y;
+    return depthA != depthB ? depthA > depthB : a.x > b.x;
+  });
+
+  for(int i = 0; i < count; i++) {
+    if(HitTest(candidates[i].x, candidates[i].y, point)) {
+      tile = candidates[i];
+      return true;
+    }
+  }
+
+  return false;
+}
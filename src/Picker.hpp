@@ -0,0 +1,28 @@
+#ifndef _PICKER_HPP_
+  #define _PICKER_HPP_
+
+#include <bitset>
+#include <map>
+#include <string>
+
+#include <SDL2pp/Point.hh>
+
+#include "Camera.hpp"
+#include "World.hpp"
+
+class Picker {
+private:
+  static const int SPRITE_SIZE = 64;
+
+  World *world;
+  Camera *camera;
+  std::map<Tile::Type, std::bitset<SPRITE_SIZE * SPRITE_SIZE>> masks;
+
+  bool HitTest(int row, int col, const SDL2pp::Point &point) const;
+public:
+  Picker(World *world, Camera *camera, const std::string &spritesPath);
+
+  bool Pick(const SDL2pp::Point &position, SDL2pp::Point &tile) const;
+};
+
+#endif
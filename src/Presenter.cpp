@@ -1,7 +1,11 @@
 #include "Game.hpp"
 #include "Presenter.hpp"
+#include "Profiler.hpp"
 
-Presenter::Presenter(bool is_composite) {
+Presenter::Presenter(const std::string &name, bool is_composite) :
+  interactZone(Profiler::Intern(name + "::Interact")),
+  renderZone(Profiler::Intern(name + "::Render"))
+{
   if(!is_composite) {
     Game::Instance()->AddPresenter(this);
   }
@@ -16,3 +20,11 @@ void Presenter::Interact(Input *input) {
 
 void Presenter::Render() {
 }
+
+bool Presenter::IsDirty() {
+  return true;
+}
+
+bool Presenter::IsAnimating() {
+  return false;
+}
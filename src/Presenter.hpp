@@ -1,16 +1,25 @@
 #ifndef _PRESENTER_HPP_
   #define _PRESENTER_HPP_
 
+#include <string>
+
 class Input;
 
 class Presenter {
 private:
+  const char *interactZone;
+  const char *renderZone;
 public:
-  Presenter(bool is_composite = false);
+  Presenter(const std::string &name = "Presenter", bool is_composite = false);
   ~Presenter();
 
   virtual void Interact(Input *input);
   virtual void Render();
+  virtual bool IsDirty();
+  virtual bool IsAnimating();
+
+  const char* GetInteractZone() const { return interactZone; }
+  const char* GetRenderZone() const { return renderZone; }
 };
 
 #endif
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <fstream>
+
+#include <fmt/format.h>
+
+#include "Profiler.hpp"
+
+Profiler Profiler::instance;
+bool Profiler::enabled = false;
+
+Profiler* Profiler::Instance() {
+  return &Profiler::instance;
+}
+
+// Keeps a built zone name alive for as long as the profiler, even after its owner is gone
+const char* Profiler::Intern(const std::string &name) {
+  return Profiler::instance.interned.insert(name).first->c_str();
+}
+
+Profiler::Profiler() {
+  frequency = SDL_GetPerformanceFrequency();
+  origin = SDL_GetPerformanceCounter();
+}
+
+void Profiler::SetEnabled(bool value) {
+  requested = value;
+}
+
+void Profiler::EndZone(const char *name, Uint64 start, int zoneDepth) {
+  depth = zoneDepth;
+  frame.push_back(Sample{name, start, Now(), zoneDepth});
+}
+
+size_t Profiler::FindZone(const Sample &sample) {
+  auto found = zoneIndices.find(sample.name);
+  if(found != std::end(zoneIndices)) return found->second;
+
+  // The same literal can live at different addresses in different translation units
+  auto named = zoneNames.find(sample.name);
+  if(named == std::end(zoneNames)) {
+    named = zoneNames.emplace(sample.name, zones.size()).first;
+    zones.push_back(ZoneHistory{sample.name, sample.depth, 0, {}});
+  }
+
+  zoneIndices.emplace(sample.name, named->second);
+  return named->second;
+}
+
+void Profiler::EndFrame() {
+  // Zones opened before a toggle would be unbalanced, so switch between frames only
+  if(enabled != requested) {
+    enabled = requested;
+    depth = 0;
+    frame.clear();
+    return;
+  }
+
+  if(frame.empty()) return;
+
+  std::stable_sort(
+    std::begin(frame),
+    std::end(frame),
+    [](const Sample &a, const Sample &b) { return a.start < b.start; }
+  );
+
+  for(const auto& sample : frame) {
+    auto &zone = zones[FindZone(sample)];
+    float duration = (sample.end - sample.start) * 1000.0f / frequency;
+    if(zone.durations.size() < HISTORY_SIZE) {
+      zone.durations.push_back(duration);
+    } else {
+      zone.durations[zone.cursor] = duration;
+    }
+    zone.cursor = (zone.cursor + 1) % HISTORY_SIZE;
+  }
+
+  if(captureFramesLeft > 0) {
+    captured.insert(std::end(captured), std::begin(frame), std::end(frame));
+    if(--captureFramesLeft == 0) {
+      WriteTrace();
+    }
+  }
+
+  frame.clear();
+}
+
+void Profiler::CaptureFrames(int count, const std::string &path) {
+  if(count <= 0) return;
+
+  SetEnabled(true);
+  captured.clear();
+  capturePath = path;
+  captureFramesLeft = count;
+}
+
+static std::string EscapeJson(const char *text) {
+  std::string escaped;
+  for(; *text != '\0'; ++text) {
+    switch(*text) {
+    case '"': escaped.append("\\\""); break;
+    case '\\': escaped.append("\\\\"); break;
+    case '\n': escaped.append("\\n"); break;
+    case '\t': escaped.append("\\t"); break;
+    default:
+      if(static_cast<unsigned char>(*text) < 0x20) {
+        escaped.append(fmt::format("\\u{:04x}", static_cast<int>(*text)));
+      } else {
+        escaped.push_back(*text);
+      }
+      break;
+    }
+  }
+  return escaped;
+}
+
+void Profiler::WriteTrace() {
+  std::ofstream out(capturePath);
+  if(!out) {
+    SDL_Log("Profiler: unable to write trace to %s", capturePath.c_str());
+    captured.clear();
+    return;
+  }
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for(const auto& sample : captured) {
+    out << fmt::format(
+      "{}{{\"name\":\"{}\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":{:.3f},\"dur\":{:.3f}}}",
+      &sample == &captured[0] ? "" : ",\n",
+      EscapeJson(sample.name),
+      (sample.start - origin) * 1000000.0 / frequency,
+      (sample.end - sample.start) * 1000000.0 / frequency
+    );
+  }
+  out << "]}\n";
+
+  SDL_Log("Profiler: wrote %d samples to %s", static_cast<int>(captured.size()), capturePath.c_str());
+  captured.clear();
+}
+
+std::vector<Profiler::ZoneSummary> Profiler::GetSummary() const {
+  std::vector<ZoneSummary> summary;
+
+  for(const auto& zone : zones) {
+    if(zone.durations.empty()) continue;
+
+    std::vector<float> sorted = zone.durations;
+    std::sort(std::begin(sorted), std::end(sorted));
+
+    float total = 0.0f;
+    for(float duration : sorted) total += duration;
+
+    auto percentile = [&sorted](float p) {
+      return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+    };
+
+    summary.push_back(ZoneSummary{
+      zone.name,
+      zone.depth,
+      total / sorted.size(),
+      percentile(0.50f),
+      percentile(0.95f),
+      percentile(0.99f),
+      sorted.back()
+    });
+  }
+
+  return summary;
+}
@@ -0,0 +1,111 @@
+#ifndef _PROFILER_HPP_
+  #define _PROFILER_HPP_
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL.h>
+
+class Profiler {
+private:
+  static Profiler instance;
+  static bool enabled;
+
+  static const int HISTORY_SIZE = 120;
+
+  // Names are string literals or interned, so they outlive every captured frame
+  struct Sample {
+    const char *name;
+    Uint64 start;
+    Uint64 end;
+    int depth;
+  };
+
+  struct ZoneHistory {
+    std::string name;
+    int depth = 0;
+    int cursor = 0;
+    std::vector<float> durations;
+  };
+
+  bool requested = false;
+  Uint64 frequency = 1;
+  Uint64 origin = 0;
+  int depth = 0;
+
+  std::vector<Sample> frame;
+  std::vector<ZoneHistory> zones;
+  std::unordered_map<const char*, size_t> zoneIndices;
+  std::map<std::string, size_t> zoneNames;
+  std::set<std::string> interned;
+
+  int captureFramesLeft = 0;
+  std::string capturePath;
+  std::vector<Sample> captured;
+
+  Profiler();
+  size_t FindZone(const Sample &sample);
+  void WriteTrace();
+public:
+  struct ZoneSummary {
+    std::string name;
+    int depth;
+    float average;
+    float p50;
+    float p95;
+    float p99;
+    float max;
+  };
+
+  static Profiler* Instance();
+  static const char* Intern(const std::string &name);
+  static bool IsEnabled() { return enabled; }
+  bool IsRequested() const { return requested; }
+
+  void SetEnabled(bool value);
+
+  Uint64 Now() const { return SDL_GetPerformanceCounter(); }
+  int BeginZone() { return depth++; }
+  void EndZone(const char *name, Uint64 start, int zoneDepth);
+  void EndFrame();
+
+  void CaptureFrames(int count, const std::string &path);
+  bool IsCapturing() const { return captureFramesLeft > 0; }
+
+  std::vector<ZoneSummary> GetSummary() const;
+};
+
+class ProfileZone {
+private:
+  const char *name;
+  Uint64 start = 0;
+  int depth = 0;
+  bool active;
+public:
+  ProfileZone(const char *name) : name(name), active(Profiler::IsEnabled()) {
+    if(active) {
+      depth = Profiler::Instance()->BeginZone();
+      start = Profiler::Instance()->Now();
+    }
+  }
+
+  ~ProfileZone() {
+    if(active) {
+      Profiler::Instance()->EndZone(name, start, depth);
+    }
+  }
+};
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef ENABLE_PROFILER
+  #define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+  #define PROFILE_ZONE(name)
+#endif
+
+#endif
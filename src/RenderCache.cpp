@@ -0,0 +1,46 @@
+#include "Game.hpp"
+#include "RenderCache.hpp"
+
+RenderCache::RenderCache(SDL2pp::Renderer &render, const SDL2pp::Rect &area) :
+  render(render),
+  area(area),
+  texture(render, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, area.w, area.h)
+{
+  // Straight alpha sprites blended onto the cleared target leave premultiplied colours behind,
+  // so compositing with plain BLEND would multiply by alpha twice and darken soft edges
+  SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+    SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+    SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD
+  );
+
+  // The software renderer has no custom blend modes, fall back to straight alpha there
+  if(SDL_SetTextureBlendMode(texture.Get(), premultiplied) != 0) {
+    texture.SetBlendMode(SDL_BLENDMODE_BLEND);
+  }
+}
+
+bool RenderCache::IsStale(unsigned int currentVersion) const {
+  // Target textures lose their contents when the renderer resets them
+  return !valid || version != currentVersion || targets != Game::Instance()->GetTargetsGeneration();
+}
+
+void RenderCache::Begin() {
+  auto oldDrawColor = render.GetDrawColor();
+
+  render.SetTarget(texture);
+  render.SetDrawColor(0, 0, 0, 0);
+  render.Clear();
+  render.SetDrawColor(oldDrawColor);
+}
+
+void RenderCache::End(unsigned int renderedVersion) {
+  render.SetTarget();
+
+  version = renderedVersion;
+  targets = Game::Instance()->GetTargetsGeneration();
+  valid = true;
+}
+
+void RenderCache::Blit(CommandBuffer &commands, int layer) {
+  commands.Copy(layer, texture, SDL2pp::Rect(0, 0, area.w, area.h), area);
+}
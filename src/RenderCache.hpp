@@ -0,0 +1,33 @@
+#ifndef _RENDERCACHE_HPP_
+  #define _RENDERCACHE_HPP_
+
+#include <SDL.h>
+#include <SDL2pp/Rect.hh>
+#include <SDL2pp/Renderer.hh>
+#include <SDL2pp/Texture.hh>
+
+#include "CommandBuffer.hpp"
+
+class RenderCache {
+private:
+  SDL2pp::Renderer &render;
+  SDL2pp::Rect area;
+  SDL2pp::Texture texture;
+
+  unsigned int version = 0;
+  unsigned int targets = 0;
+  bool valid = false;
+public:
+  RenderCache(SDL2pp::Renderer &render, const SDL2pp::Rect &area);
+
+  bool IsStale(unsigned int currentVersion) const;
+  void Invalidate() { valid = false; }
+
+  void Begin();
+  void End(unsigned int renderedVersion);
+  void Blit(CommandBuffer &commands, int layer);
+
+  const SDL2pp::Rect& GetArea() const { return area; }
+};
+
+#endif
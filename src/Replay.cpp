@@ -0,0 +1,73 @@
+#include <fstream>
+
+#include "Input.hpp"
+#include "Replay.hpp"
+
+void Replay::StartRecording(const std::string &path, unsigned int seed) {
+  mode = Mode::Record;
+  this->path = path;
+  this->seed = seed;
+  frames.clear();
+}
+
+bool Replay::StartPlayback(const std::string &path) {
+  std::ifstream in(path);
+  if(!in) return false;
+
+  std::string tag;
+  if(!(in >> tag >> seed) || tag != "seed") return false;
+
+  frames.clear();
+  while(in >> tag) {
+    if(tag == "frame") {
+      Frame frame;
+      in >> frame.elapsed;
+      frames.push_back(frame);
+    } else if(tag == "event" && !frames.empty()) {
+      InputEvent event;
+      int type;
+      in >> type >> event.timestamp >> event.code >> event.x >> event.y;
+      event.type = static_cast<InputEvent::Type>(type);
+      frames.back().events.push_back(event);
+    } else {
+      return false;
+    }
+  }
+
+  mode = Mode::Playback;
+  this->path = path;
+  cursor = 0;
+  return true;
+}
+
+bool Replay::Save() const {
+  std::ofstream out(path);
+  if(!out) return false;
+
+  out << "seed " << seed << "\n";
+  for(const auto& frame : frames) {
+    out << "frame " << frame.elapsed << "\n";
+    for(const auto& event : frame.events) {
+      out << "event " << static_cast<int>(event.type) << " " << event.timestamp << " "
+          << event.code << " " << event.x << " " << event.y << "\n";
+    }
+  }
+
+  return static_cast<bool>(out);
+}
+
+void Replay::RecordFrame(Uint32 elapsed, const std::vector<InputEvent> &events) {
+  frames.push_back(Frame{elapsed, events});
+}
+
+bool Replay::PlayFrame(Input *input, Uint32 &elapsed) {
+  if(cursor >= frames.size()) return false;
+
+  const Frame &frame = frames[cursor++];
+  elapsed = frame.elapsed;
+  for(const auto& event : frame.events) {
+    input->PushEvent(event);
+  }
+
+  return true;
+}
@@ -0,0 +1,46 @@
+#ifndef _REPLAY_HPP_
+  #define _REPLAY_HPP_
+
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+#include "InputEvent.hpp"
+
+class Input;
+
+class Replay {
+public:
+  enum class Mode {
+    Null,
+    Record,
+    Playback
+  };
+private:
+  struct Frame {
+    Uint32 elapsed;
+    std::vector<InputEvent> events;
+  };
+
+  Mode mode = Mode::Null;
+  std::string path;
+  unsigned int seed = 0;
+  std::vector<Frame> frames;
+  size_t cursor = 0;
+public:
+  void StartRecording(const std::string &path, unsigned int seed);
+  bool StartPlayback(const std::string &path);
+  bool Save() const;
+
+  void RecordFrame(Uint32 elapsed, const std::vector<InputEvent> &events);
+  bool PlayFrame(Input *input, Uint32 &elapsed);
+
+  Mode GetMode() const { return mode; }
+  bool IsRecording() const { return mode == Mode::Record; }
+  bool IsPlaying() const { return mode == Mode::Playback; }
+  unsigned int GetSeed() const { return seed; }
+  size_t GetFrameCount() const { return frames.size(); }
+};
+
+#endif
@@ -0,0 +1,73 @@
+#include "Profiler.hpp"
+#include "SpriteBatch.hpp"
+
+SpriteBatch::SpriteBatch(SDL2pp::Renderer &render) : render(render) {
+}
+
+void SpriteBatch::Add(SDL2pp::Texture &spriteTexture, const SDL2pp::Rect &source, const SDL2pp::Rect &destination) {
+  if(texture != &spriteTexture) {
+    Flush();
+    texture = &spriteTexture;
+  }
+
+  sprites.push_back(Sprite{source, destination});
+}
+
+void SpriteBatch::Flush() {
+  if(sprites.empty()) return;
+
+  PROFILE_ZONE("SpriteBatch::Flush");
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  if(!SubmitGeometry())
+#endif
+  {
+    for(const auto& sprite : sprites) {
+      render.Copy(*texture, sprite.source, sprite.destination);
+    }
+  }
+
+  sprites.clear();
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+bool SpriteBatch::SubmitGeometry() {
+  float width = static_cast<float>(texture->GetWidth());
+  float height = static_cast<float>(texture->GetHeight());
+  SDL_Color white = {255, 255, 255, 255};
+
+  vertices.clear();
+  indices.clear();
+  vertices.reserve(sprites.size() * 4);
+  indices.reserve(sprites.size() * 6);
+
+  for(const auto& sprite : sprites) {
+    float x0 = static_cast<float>(sprite.destination.x);
+    float y0 = static_cast<float>(sprite.destination.y);
+    float x1 = static_cast<float>(sprite.destination.x + sprite.destination.w);
+    float y1 = static_cast<float>(sprite.destination.y + sprite.destination.h);
+
+    float u0 = sprite.source.x / width;
+    float v0 = sprite.source.y / height;
+    float u1 = (sprite.source.x + sprite.source.w) / width;
+    float v1 = (sprite.source.y + sprite.source.h) / height;
+
+    int base = static_cast<int>(vertices.size());
+    vertices.push_back(SDL_Vertex{{x0, y0}, white, {u0, v0}});
+    vertices.push_back(SDL_Vertex{{x1, y0}, white, {u1, v0}});
+    vertices.push_back(SDL_Vertex{{x1, y1}, white, {u1, v1}});
+    vertices.push_back(SDL_Vertex{{x0, y1}, white, {u0, v1}});
+
+    indices.insert(std::end(indices), {base, base + 1, base + 2, base, base + 2, base + 3});
+  }
+
+  return SDL_RenderGeometry(
+    render.Get(),
+    texture->Get(),
+    vertices.data(),
+    static_cast<int>(vertices.size()),
+    indices.data(),
+    static_cast<int>(indices.size())
+  ) == 0;
+}
+#endif
@@ -0,0 +1,35 @@
+#ifndef _SPRITEBATCH_HPP_
+  #define _SPRITEBATCH_HPP_
+
+#include <vector>
+
+#include <SDL.h>
+#include <SDL2pp/Rect.hh>
+#include <SDL2pp/Renderer.hh>
+#include <SDL2pp/Texture.hh>
+
+class SpriteBatch {
+private:
+  struct Sprite {
+    SDL2pp::Rect source;
+    SDL2pp::Rect destination;
+  };
+
+  SDL2pp::Renderer &render;
+  SDL2pp::Texture *texture = nullptr;
+  std::vector<Sprite> sprites;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+
+  bool SubmitGeometry();
+#endif
+public:
+  SpriteBatch(SDL2pp::Renderer &render);
+
+  void Add(SDL2pp::Texture &spriteTexture, const SDL2pp::Rect &source, const SDL2pp::Rect &destination);
+  void Flush();
+};
+
+#endif
@@ -0,0 +1,155 @@
+#include <algorithm>
+
+#include "LocalCoordinates.hpp"
+#include "Profiler.hpp"
+#include "SpriteLayer.hpp"
+
+namespace {
+  int FloorDiv(int a, int b) {
+    return a / b - (a % b != 0 && (a < 0) != (b < 0));
+  }
+}
+
+SDL2pp::Rect SpriteLayer::GetTileRect(int row, int col) {
+  return SDL2pp::Rect(LocalCoordinates::Isometric(SDL2pp::Point(row * 32, col * 32)), SDL2pp::Point(64, 64));
+}
+
+long long SpriteLayer::GetCellKey(int row, int col) {
+  return (static_cast<long long>(row) << 32) ^ static_cast<unsigned int>(col);
+}
+
+long long SpriteLayer::GetCell(const SDL2pp::Rect &destination) {
+  // Inverse of the isometric projection, x = 32 * (row - col) and y = 16 * (row + col)
+  int x = destination.x, y = destination.y;
+  return GetCellKey(FloorDiv(x + 2 * y, 64), FloorDiv(2 * y - x, 64));
+}
+
+void SpriteLayer::Link(int id) {
+  Sprite &sprite = sprites[id];
+  sprite.cell = GetCell(sprite.destination);
+  cells[sprite.cell].push_back(id);
+}
+
+void SpriteLayer::Unlink(int id) {
+  auto found = cells.find(sprites[id].cell);
+  std::vector<int> &ids = found->second;
+  ids.erase(std::find(std::begin(ids), std::end(ids), id));
+  if(ids.empty()) cells.erase(found);
+}
+
+void SpriteLayer::Extend(const Sprite &sprite) {
+  widths[sprite.destination.w]++;
+  heights[sprite.destination.h]++;
+}
+
+void SpriteLayer::Shrink(const Sprite &sprite) {
+  auto width = widths.find(sprite.destination.w);
+  if(--width->second == 0) widths.erase(width);
+
+  auto height = heights.find(sprite.destination.h);
+  if(--height->second == 0) heights.erase(height);
+}
+
+int SpriteLayer::Add(SDL2pp::Texture &texture, const SDL2pp::Rect &source, const SDL2pp::Rect &destination, int depth) {
+  int id;
+  if(freeIds.empty()) {
+    id = static_cast<int>(sprites.size());
+    sprites.push_back(Sprite{&texture, source, destination, depth, 0, 0});
+  } else {
+    id = freeIds.back();
+    freeIds.pop_back();
+    sprites[id] = Sprite{&texture, source, destination, depth, 0, 0};
+  }
+
+  Link(id);
+  Extend(sprites[id]);
+  order.emplace(depth, id);
+  count++;
+  version++;
+  return id;
+}
+
+void SpriteLayer::Remove(int id) {
+  Unlink(id);
+  Shrink(sprites[id]);
+  order.erase(std::make_pair(sprites[id].depth, id));
+  sprites[id].texture = nullptr;
+  freeIds.push_back(id);
+  count--;
+  version++;
+}
+
+void SpriteLayer::Move(int id, const SDL2pp::Rect &destination, int depth) {
+  Sprite &sprite = sprites[id];
+  if(sprite.destination == destination && sprite.depth == depth) return;
+
+  if(sprite.depth != depth) {
+    order.erase(std::make_pair(sprite.depth, id));
+    order.emplace(depth, id);
+  }
+
+  Shrink(sprite);
+  sprite.destination = destination;
+  sprite.depth = depth;
+  Extend(sprite);
+  if(GetCell(destination) != sprite.cell) {
+    Unlink(id);
+    Link(id);
+  }
+
+  version++;
+}
+
+void SpriteLayer::SetSource(int id, const SDL2pp::Rect &source) {
+  if(sprites[id].source == source) return;
+
+  sprites[id].source = source;
+  version++;
+}
+
+void SpriteLayer::Render(SpriteBatch &batch, const Camera &camera, const SDL2pp::Point &offset) const {
+  PROFILE_ZONE("SpriteLayer::Render");
+
+  if(order.empty()) return;
+
+  // A sprite is visible when its top-left lies within the area grown by the largest sprite size
+  SDL2pp::Rect area = camera.GetVisibleArea();
+  int left = area.x - widths.rbegin()->first, right = area.x + area.w;
+  int top = area.y - heights.rbegin()->first, bottom = area.y + area.h;
+
+  // Project the corners back to tiles, then clip each row's columns to the x and y extents
+  int rowMin = FloorDiv(left + 2 * top, 64), rowMax = FloorDiv(right + 2 * bottom, 64);
+  size_t visible = 0;
+  frame++;
+  for(int row = rowMin; row <= rowMax; row++) {
+    int colMin = std::max(row - FloorDiv(right, 32) - 1, FloorDiv(top, 16) - row - 1);
+    int colMax = std::min(row - FloorDiv(left, 32), FloorDiv(bottom, 16) - row);
+
+    for(int col = colMin; col <= colMax; col++) {
+      auto found = cells.find(GetCellKey(row, col));
+      if(found == std::end(cells)) continue;
+
+      for(int id : found->second) {
+        const SDL2pp::Rect &destination = sprites[id].destination;
+        if(destination.x < right && destination.x + destination.w > area.x && destination.y < bottom && destination.y + destination.h > area.y) {
+          sprites[id].visibleFrame = frame;
+          visible++;
+        }
+      }
+    }
+  }
+
+  // Walk the kept order up to the last visible sprite instead of sorting the visible ones
+  for(auto entry = std::begin(order); visible > 0 && entry != std::end(order); ++entry) {
+    const Sprite &sprite = sprites[entry->second];
+    if(sprite.visibleFrame != frame) continue;
+
+    visible--;
+    if(sprite.source.w == 0 || sprite.source.h == 0) continue;
+
+    SDL2pp::Point topLeft = camera.ToScreen(sprite.destination.GetTopLeft()) - offset;
+    SDL2pp::Point bottomRight = camera.ToScreen(sprite.destination.GetTopLeft() + sprite.destination.GetSize()) - offset;
+    batch.Add(*sprite.texture, sprite.source, SDL2pp::Rect(topLeft, bottomRight - topLeft));
+  }
+  batch.Flush();
+}
@@ -0,0 +1,63 @@
+#ifndef _SPRITELAYER_HPP_
+  #define _SPRITELAYER_HPP_
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <SDL2pp/Point.hh>
+#include <SDL2pp/Rect.hh>
+#include <SDL2pp/Texture.hh>
+
+#include "Camera.hpp"
+#include "SpriteBatch.hpp"
+
+class SpriteLayer {
+private:
+  struct Sprite {
+    SDL2pp::Texture *texture;
+    SDL2pp::Rect source;
+    SDL2pp::Rect destination;
+    int depth;
+    long long cell;
+    mutable unsigned int visibleFrame;
+  };
+
+  std::vector<Sprite> sprites;
+  std::vector<int> freeIds;
+  std::unordered_map<long long, std::vector<int>> cells;
+  // Draw order, by depth and then id, kept up to date as sprites come, go and move
+  std::set<std::pair<int, int>> order;
+  // How many sprites have each size, the largest sizes are the culling margins
+  std::map<int, int> widths;
+  std::map<int, int> heights;
+  mutable unsigned int frame = 0;
+
+  size_t count = 0;
+  unsigned int version = 0;
+
+  static long long GetCellKey(int row, int col);
+  static long long GetCell(const SDL2pp::Rect &destination);
+
+  void Link(int id);
+  void Unlink(int id);
+  void Extend(const Sprite &sprite);
+  void Shrink(const Sprite &sprite);
+public:
+  static int GetTileDepth(int row, int col) { return (row + col) * 16 + 32; }
+  static SDL2pp::Rect GetTileRect(int row, int col);
+
+  int Add(SDL2pp::Texture &texture, const SDL2pp::Rect &source, const SDL2pp::Rect &destination, int depth);
+  void Remove(int id);
+  void Move(int id, const SDL2pp::Rect &destination, int depth);
+  void SetSource(int id, const SDL2pp::Rect &source);
+
+  void Render(SpriteBatch &batch, const Camera &camera, const SDL2pp::Point &offset) const;
+
+  size_t GetCount() const { return count; }
+  unsigned int GetVersion() const { return version; }
+};
+
+#endif
@@ -1,12 +1,21 @@
 #include <fmt/format.h>
 #include "World.hpp"
+#include "Profiler.hpp"
 
-World::World() {
+World::World() : World(time(nullptr)) {
+}
+
+World::World(unsigned int seed) : seed(seed) {
   Initialize();
 }
 
+World::World(Catalog) {
+}
+
 void World::Initialize() {
-  srand(time(nullptr));
+  // Reseed from the generator itself so restarts stay reproducible for a given seed
+  srand(seed);
+  seed = rand();
 
   tick = 0;
   elapsedFromTick = 0.0;
@@ -28,6 +37,7 @@ void World::Initialize() {
   SetResource(Resource::Science,             0);
   SetResource(Resource::DaysUntilEvacuation, 10);
   resources[Resource::Tiles] =               64;
+  previousResources = resources;
 
   EmitEvent(Event::Type::Start);
   AddLog("Game has been started");
@@ -42,6 +52,8 @@ void World::Generate() {
 
   foundation[Rand(6)][Rand(6)] = Tile::Type::Biodome;
   foundation[Rand(6)][Rand(6)] = Tile::Type::OxygenTank;
+  foundationVersion++;
+  version++;
   buildings.push_back(Building::Type::Biodome);
   buildings.push_back(Building::Type::OxygenTank);
 }
@@ -65,12 +77,18 @@ void World::Update(float elapsed) {
   if(elapsedFromTick >= 1000) {
     elapsedFromTick = 0.0;
     tick += 1;
+    version++;
 
+    previousResources = resources;
+    ticking = true;
     Tick();
+    ticking = false;
   }
 }
 
 void World::Tick() {
+  PROFILE_ZONE("World::Tick");
+
   CheckWinLose();
 
   for(const auto& buildingType : buildings) {
@@ -160,6 +178,8 @@ void World::RemoveTile(int count) {
     if(tile != Tile::Type::Null) {
       RemoveBuilding(randomX, randomY);
       foundation[randomX][randomY] = Tile::Type::Null;
+      foundationVersion++;
+      version++;
     }
   }
 }
@@ -171,10 +191,13 @@ void World::SetResource(Resource res, int amount) {
   if(res == Resource::Tiles && amount > resources[res]) return;
   if(res == Resource::Tiles) RemoveTile(resources[res] - amount);
 
+  int before = resources[res];
+
   if(resources[res] < amount) {
     totalResources[res] += amount - resources[res];
   }
 
+  version++;
   resources[res] = amount;
   if(resources[res] < 0) {
     resources[res] = 0;
@@ -186,6 +209,27 @@ void World::SetResource(Resource res, int amount) {
       resources[Resource::Oxygen] = maxOxygen;
     }
   }
+
+  // Changes made by the player show up at once instead of blending in over the tick
+  if(!ticking) {
+    previousResources[res] += resources[res] - before;
+  }
+}
+
+float World::GetInterpolation() const {
+  if(currentEvent != nullptr) return 1.0f;
+
+  return std::min(1.0f, elapsedFromTick / 1000.0f);
+}
+
+float World::GetBlendedResource(Resource res) const {
+  auto current = resources.find(res);
+  if(current == std::end(resources)) return 0.0f;
+
+  auto previous = previousResources.find(res);
+  if(previous == std::end(previousResources)) return current->second;
+
+  return previous->second + (current->second - previous->second) * GetInterpolation();
 }
 
 bool World::TryToBuild(Building::Type building, int x, int y) {
@@ -213,6 +257,8 @@ bool World::TryToBuild(Building::Type building, int x, int y) {
   for(const auto& res : cost) UpdateResource(res.first, -res.second);
   buildings.push_back(building);
   foundation[x][y] = Building::Tiles[building];
+  foundationVersion++;
+  version++;
   return true;
 }
 
@@ -228,11 +274,13 @@ void World::RemoveBuilding(int x, int y) {
 void World::EmitEvent(Event::Type type) {
   currentEventStep = 0;
   currentEvent = eventInfos[type];
+  version++;
   HandleStepEvent(currentEventStep);
 }
 
 bool World::HandleStepEvent(int step) {
   if(currentEvent == nullptr) return false;
+  version++;
 
   if(step == -1) {
     switch(currentEvent->type) {
@@ -243,6 +291,8 @@ bool World::HandleStepEvent(int step) {
     default:
       currentEventStep = 0;
       currentEvent = nullptr;
+      // The counters showed the tick's result while the event was up, blend on from there
+      previousResources = resources;
       break;
     }
 
@@ -311,7 +361,29 @@ std::string World::GetStatus() {
 }
 
 std::vector<std::string>& World::GetLog() { return worldLog; }
+
+unsigned int World::GetDigest() const {
+  unsigned int digest = 2166136261u;
+  auto mix = [&digest](int value) {
+    digest = (digest ^ static_cast<unsigned int>(value)) * 16777619u;
+  };
+
+  mix(tick);
+  for(const auto& res : resources) {
+    mix(static_cast<int>(res.first));
+    mix(res.second);
+  }
+
+  for(const auto& tileRow : foundation) {
+    for(const auto& tile : tileRow) {
+      mix(static_cast<int>(tile));
+    }
+  }
+
+  return digest;
+}
 void World::AddLog(const std::string &str) {
   worldLog.resize(15);
   worldLog.insert(worldLog.begin(), str);
+  version++;
 }
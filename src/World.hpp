@@ -135,13 +135,18 @@ private:
   std::array<std::array<Tile::Type, SIZE>, SIZE> foundation = {Tile::Type::Null};
 
   std::map<Resource, int> resources;
+  std::map<Resource, int> previousResources;
   std::map<Resource, int> totalResources;
 
   std::vector<Building::Type> buildings;
   std::vector<std::string> worldLog;
 
+  unsigned int seed = 0;
   int tick = 0;
   float elapsedFromTick = 0.0;
+  bool ticking = false;
+  unsigned int version = 0;
+  unsigned int foundationVersion = 0;
 
   int currentEventStep = 0;
   Event::Info *currentEvent = nullptr;
@@ -710,21 +715,36 @@ private:
     Event::Type::Landfall,
   };
 public:
+  // Tag for a world that only holds the building and event tables, without seeding rand() or generating a map
+  struct Catalog {};
+
   World();
+  World(unsigned int seed);
+  explicit World(Catalog);
 
   void Initialize();
   void Generate();
   void CheckWinLose();
 
   void Update(float elapsed) override;
+  bool IsIdle() const override { return HasEvent(); }
   void Tick();
 
+  unsigned int GetVersion() const { return version; }
+  unsigned int GetFoundationVersion() const { return foundationVersion; }
+  static int GetSize() { return SIZE; }
+  unsigned int GetDigest() const;
+
   SDL2pp::Rect GetTile(Tile::Type type) const { return Tile::Tiles[type]; }
   SDL2pp::Rect GetTile(Building::Type type) const { return Tile::Tiles[Building::Tiles[type]]; }
   std::array<std::array<Tile::Type, SIZE>, SIZE>& GetFoundation() { return foundation; }
   void RemoveTile(int count);
 
+  int GetTick() const { return tick; }
+  float GetInterpolation() const;
+
   int GetResource(Resource res);
+  float GetBlendedResource(Resource res) const;
   void SetResource(Resource res, int amount);
   void UpdateResource(Resource res, int amount);
   std::string GetResourceName(Resource res);
@@ -739,6 +759,7 @@ public:
   std::vector<std::pair<std::string, SDL2pp::Color>> GetEventText();
   int GetCurrentEventStep() const { return currentEventStep; }
   Event::Info* GetCurrentEvent() const { return currentEvent; }
+  const std::map<Event::Type, Event::Info*>& GetEventInfos() const { return eventInfos; }
 
   std::string GetStatus();
   std::vector<std::string>& GetLog();
@@ -2,14 +2,32 @@
 	#include <emscripten.h>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+
 #include <SDL2pp/Texture.hh>
 #include <SDL2pp/Exception.hh>
 #include <NFont.h>
+#include <SDL_FontCache.h>
 #include <fmt/format.h>
 
+#include "Camera.hpp"
+#include "CommandBuffer.hpp"
 #include "Game.hpp"
+#include "Golden.hpp"
+#include "Picker.hpp"
 #include "Input.hpp"
 #include "Presenter.hpp"
+#include "Profiler.hpp"
+#include "RenderCache.hpp"
+#include "Replay.hpp"
+#include "SpriteBatch.hpp"
+#include "SpriteLayer.hpp"
 #include "LocalCoordinates.hpp"
 
 #include "World.hpp"
@@ -21,14 +39,16 @@ using Color = SDL2pp::Color;
 class ModalUI : Presenter {
 private:
   SDL2pp::Renderer &render = Game::Instance()->GetRender();
-  NFont font = NFont(render.Get(), "./assets/Fontana.ttf", 18);
+  std::shared_ptr<NFont> font = Game::Instance()->GetAssets().GetFont("./assets/Fontana.ttf", 18);
+  CommandBuffer &commands = Game::Instance()->GetCommands();
 
   World *world;
   int step = 0;
   Event::Info *event = nullptr;
+  unsigned int renderedVersion = 0;
   LocalCoordinates lc = LocalCoordinates([] (Point point) { return point + Point(100, 147); });
 public:
-  ModalUI(World *world) : world(world) {
+  ModalUI(World *world) : Presenter("ModalUI"), world(world) {
   }
 
   void Interact(Input *input) override {
@@ -47,50 +67,53 @@ public:
     }
   }
 
+  bool IsDirty() override {
+    return world->GetVersion() != renderedVersion;
+  }
+
   void Render() override {
+    renderedVersion = world->GetVersion();
     if(!world->HasEvent()) return;
 
-    Color oldDrawColor = render.GetDrawColor();
-
-    render.SetDrawColor(Color(0, 0, 0));
-    render.DrawRect(Rect(lc.t(Point(0, 0)), Point(700, 400)));
-    render.DrawRect(Rect(lc.t(Point(1, 1)), Point(698, 398)));
-
-    render.SetDrawColor(Color(192, 192, 192));
-    render.FillRect(Rect(lc.t(Point(2, 2)), Point(696, 396)));
+    const int layer = CommandBuffer::MODAL_LAYER;
+    commands.DrawRect(layer, Rect(lc.t(Point(0, 0)), Point(700, 400)), Color(0, 0, 0));
+    commands.DrawRect(layer, Rect(lc.t(Point(1, 1)), Point(698, 398)), Color(0, 0, 0));
+    commands.FillRect(layer, Rect(lc.t(Point(2, 2)), Point(696, 396)), Color(192, 192, 192));
 
     auto height = 0;
     for(const auto& text : world->GetEventText()) {
-      font.drawBox(
-        render.Get(),
-        Rect(lc.t(Point(12, 12 + height)), Point(676, 376 - height)),
-        text.second,
-        "%s",
-        text.first.c_str()
-      );
+      Rect box = Rect(lc.t(Point(12, 12 + height)), Point(676, 376 - height));
+      commands.Custom(layer + 1, [this, box, text] {
+        PROFILE_ZONE("NFont::drawBox");
+        font->drawBox(render.Get(), box, text.second, text.first);
+      });
 
-      height += font.getColumnHeight(676, "%s", text.first.c_str());
+      height += font->getColumnHeight(676, text.first);
     }
-
-    render.SetDrawColor(oldDrawColor);
   }
 };
 
 class BuildUI : Presenter {
 private:
   SDL2pp::Renderer &render = Game::Instance()->GetRender();
-  SDL2pp::Texture ground = SDL2pp::Texture(render, "./assets/isometric.png");
-  NFont font = NFont(render.Get(), "./assets/Fontana.ttf", 14);
+  std::shared_ptr<SDL2pp::Texture> ground = Game::Instance()->GetAssets().GetTexture("./assets/isometric.png");
+  std::shared_ptr<NFont> font = Game::Instance()->GetAssets().GetFont("./assets/Fontana.ttf", 14);
+  CommandBuffer &commands = Game::Instance()->GetCommands();
+  // The cards are drawn into their cache right away, apart from the frame
+  CommandBuffer cardCommands = CommandBuffer(render);
 
   World *world;
+  Picker *picker;
+  SpriteLayer *sprites;
+  int previewSprite = -1;
   Building::Type hoveredBuilding = Building::Type::Null;
   std::pair<Building::Type, Point> draggedBuilding = {Building::Type::Null, Point(0, 0)};
   std::map<Building::Type, Rect> colliders;
-public:
-  BuildUI(World *world) : world(world) {
-  }
+  RenderCache cards;
+  unsigned int renderedVersion = 0;
+  bool dirty = true;
 
-  void Interact(Input *input) override {
+  void UpdateDrag(Input *input) {
     if(world->HasEvent()) {
       draggedBuilding.first = Building::Type::Null;
       return;
@@ -105,11 +128,8 @@ public:
       }
 
       if(input->Mouse()->ButtonTriggered(SDL_BUTTON_LEFT)) {
-        Point groundPoint = mousePosition - SDL2pp::Point(642, 64);
-        int x = (groundPoint.x + 2 * groundPoint.y) / 64 - 1;
-        int y = (groundPoint.y * 2 - groundPoint.x) / 64;
-
-        if(world->TryToBuild(draggedBuilding.first, x, y)) {
+        Point tile;
+        if(picker->Pick(mousePosition, tile) && world->TryToBuild(draggedBuilding.first, tile.x, tile.y)) {
           draggedBuilding.first = Building::Type::Null;
         }
       }
@@ -127,169 +147,905 @@ public:
       draggedBuilding.second = mousePosition;
     }
   }
+  void UpdatePreview() {
+    Point tile;
+    if(draggedBuilding.first == Building::Type::Null || !picker->Pick(draggedBuilding.second, tile)) {
+      if(previewSprite >= 0) {
+        sprites->Remove(previewSprite);
+        previewSprite = -1;
+      }
+      return;
+    }
 
-  void RenderCard(int index, const Building::Info *info) {
-    LocalCoordinates lc([=] (Point point) {
-      return point + Point(32, 32 + index * 120);
-    });
+    // One step in front of the picked tile and behind everything on the next diagonal
+    Rect destination = SpriteLayer::GetTileRect(tile.x, tile.y);
+    int depth = SpriteLayer::GetTileDepth(tile.x, tile.y) + 1;
+    if(previewSprite < 0) {
+      previewSprite = sprites->Add(*ground, world->GetTile(draggedBuilding.first), destination, depth);
+    } else {
+      sprites->SetSource(previewSprite, world->GetTile(draggedBuilding.first));
+      sprites->Move(previewSprite, destination, depth);
+    }
+  }
+public:
+  BuildUI(World *world, Picker *picker, SpriteLayer *sprites) :
+    Presenter("BuildUI"),
+    world(world),
+    picker(picker),
+    sprites(sprites),
+    cards(render, Rect(32, 32, 320, world->GetBuildingInfos().size() * 120 - 8))
+  {
+    int index = 0;
+    for(const auto& el : world->GetBuildingInfos()) {
+      colliders[el.first] = Rect(cards.GetArea().GetTopLeft() + Point(0, index * 120), Point(320, 112));
+      index++;
+    }
+  }
 
-    if(colliders.count(info->type) == 0) {
-      colliders[info->type] = Rect(lc.t(Point(0, 0)), Point(320, 112));
+  ~BuildUI() {
+    if(previewSprite >= 0) {
+      sprites->Remove(previewSprite);
     }
+  }
+
+  void Interact(Input *input) override {
+    auto previousHovered = hoveredBuilding;
+    auto previousDragged = draggedBuilding;
 
-    Color oldDrawColor = render.GetDrawColor();
+    UpdateDrag(input);
+    UpdatePreview();
 
-    if(hoveredBuilding == info->type) {
-      render.SetDrawColor(Color(0, 0, 255));
-    } else {
-      render.SetDrawColor(Color(0, 0, 0));
+    if(hoveredBuilding != previousHovered) {
+      cards.Invalidate();
+    }
+
+    if(hoveredBuilding != previousHovered || draggedBuilding != previousDragged) {
+      dirty = true;
     }
-    render.DrawRect(Rect(lc.t(Point(0, 0)), Point(320, 112)));
-    render.DrawRect(Rect(lc.t(Point(1, 1)), Point(318, 110)));
+  }
+
+  bool IsDirty() override {
+    return dirty || world->GetVersion() != renderedVersion;
+  }
+
+  void RenderCard(int index, const Building::Info *info) {
+    LocalCoordinates lc([=] (Point point) {
+      return point + Point(0, index * 120);
+    });
 
-    render.SetDrawColor(Color(192, 192, 192));
-    render.FillRect(Rect(lc.t(Point(2, 2)), Point(316, 108)));
+    Color borderColor = hoveredBuilding == info->type ? Color(0, 0, 255) : Color(0, 0, 0);
+    cardCommands.DrawRect(0, Rect(lc.t(Point(0, 0)), Point(320, 112)), borderColor);
+    cardCommands.DrawRect(0, Rect(lc.t(Point(1, 1)), Point(318, 110)), borderColor);
+    cardCommands.FillRect(0, Rect(lc.t(Point(2, 2)), Point(316, 108)), Color(192, 192, 192));
 
-    render.Copy(ground, world->GetTile(info->type), Rect(lc.t(Point(16, 16)), Point(64, 64)));
+    cardCommands.Copy(1, *ground, world->GetTile(info->type), Rect(lc.t(Point(16, 16)), Point(64, 64)));
 
     std::string cost = "";
     for(const auto& res : info->cost) {
       cost.append(fmt::format("{} {} ", res.second, world->GetResourceName(res.first)));
     }
-    font.drawBox(render.Get(), Rect(lc.t(Point(96, 16)), Point(216, 14)), "%s", cost.c_str());
+    std::string description = fmt::format("{}\n{}", info->name, info->description);
+    Rect costBox = Rect(lc.t(Point(96, 16)), Point(216, 14));
+    Rect descriptionBox = Rect(lc.t(Point(96, 40)), Point(216, 58));
 
-    font.drawBox(
-      render.Get(),
-      Rect(lc.t(Point(96, 40)), Point(216, 58)),
-      "%s\n%s",
-      info->name.c_str(),
-      info->description.c_str()
-    );
+    cardCommands.Custom(1, [this, costBox, cost, descriptionBox, description] {
+      PROFILE_ZONE("NFont::drawBox");
+      font->drawBox(render.Get(), costBox, cost);
+      font->drawBox(render.Get(), descriptionBox, description);
+    });
+  }
 
-    if(draggedBuilding.first != Building::Type::Null) {
-      render.Copy(
-        ground,
+  void Render() override {
+    dirty = false;
+    renderedVersion = world->GetVersion();
+
+    if(cards.IsStale(world->GetVersion())) {
+      PROFILE_ZONE("BuildUI::RenderCards");
+
+      cards.Begin();
+      int index = 0;
+      for(const auto& el : world->GetBuildingInfos()) {
+        RenderCard(index, el.second);
+        index++;
+      }
+      cardCommands.Submit();
+      cards.End(world->GetVersion());
+    }
+    cards.Blit(commands, CommandBuffer::PANEL_LAYER);
+
+    if(draggedBuilding.first != Building::Type::Null && previewSprite < 0) {
+      commands.Copy(
+        CommandBuffer::DRAG_LAYER,
+        *ground,
         world->GetTile(draggedBuilding.first),
         Rect(draggedBuilding.second - Point(32, 32), Point(64, 64))
       );
     }
-
-    render.SetDrawColor(oldDrawColor);
-  }
-
-  void Render() override {
-    int index = 0;
-    for(const auto& el : world->GetBuildingInfos()) {
-      RenderCard(index, el.second);
-      index++;
-    }
   }
 };
 
 class ResourceUI : Presenter {
 private:
   SDL2pp::Renderer &render = Game::Instance()->GetRender();
-  NFont font = NFont(render.Get(), "./assets/Fontana.ttf", 14);
+  std::shared_ptr<NFont> font = Game::Instance()->GetAssets().GetFont("./assets/Fontana.ttf", 14);
+  CommandBuffer &commands = Game::Instance()->GetCommands();
+  // The panel is drawn into its cache right away, apart from the frame
+  CommandBuffer panelCommands = CommandBuffer(render);
 
   World *world;
-public:
-  ResourceUI(World *world) : world(world) {
-  }
+  RenderCache panel = RenderCache(render, Rect(400, 392, 568, 232));
+  unsigned int renderedVersion = 0;
 
-  void Render() override {
-    LocalCoordinates lc([=] (Point point) {
-      return point + Point(400, 392);
-    });
+  std::array<Resource, 6> shownResources = {
+    Resource::Peoples,
+    Resource::Food,
+    Resource::Oxygen,
+    Resource::Minerals,
+    Resource::Gas,
+    Resource::Science
+  };
+  std::array<int, 6> shownValues = {0};
 
-    Color oldDrawColor = render.GetDrawColor();
+  std::array<int, 6> GetBlendedValues() const {
+    std::array<int, 6> values;
+    for(size_t i = 0; i < shownResources.size(); i++) {
+      values[i] = static_cast<int>(std::lround(world->GetBlendedResource(shownResources[i])));
+    }
+    return values;
+  }
 
-    render.SetDrawColor(Color(0, 0, 0));
-    render.DrawRect(Rect(lc.t(Point(0, 0)), Point(568, 232)));
-    render.DrawRect(Rect(lc.t(Point(1, 1)), Point(566, 230)));
+  void RenderPanel() {
+    panelCommands.DrawRect(0, Rect(Point(0, 0), Point(568, 232)), Color(0, 0, 0));
+    panelCommands.DrawRect(0, Rect(Point(1, 1), Point(566, 230)), Color(0, 0, 0));
+    panelCommands.FillRect(0, Rect(Point(2, 2), Point(564, 228)), Color(192, 192, 192));
+    panelCommands.Custom(1, [this] { RenderText(); });
+    panelCommands.Submit();
+  }
 
-    render.SetDrawColor(Color(192, 192, 192));
-    render.FillRect(Rect(lc.t(Point(2, 2)), Point(564, 228)));
+  void RenderText() {
+    PROFILE_ZONE("NFont::drawBox");
 
-    font.drawBox(
-      render.Get(),
-      Rect(lc.t(Point(424, 12)), Point(80, 96)),
-      "People:\nFood:\nOxygen:\nMinerals:\nGas:\nScience:"
-    );
+    static const std::string labels = "People:\nFood:\nOxygen:\nMinerals:\nGas:\nScience:";
+    font->drawBox(render.Get(), Rect(Point(424, 12), Point(80, 96)), labels);
 
-    font.drawBox(
+    font->drawBox(
       render.Get(),
-      Rect(lc.t(Point(504, 12)), Point(40, 96)),
-      "%d\n%d\n%d\n%d\n%d\n%d",
-      world->GetResource(Resource::Peoples),
-      world->GetResource(Resource::Food),
-      world->GetResource(Resource::Oxygen),
-      world->GetResource(Resource::Minerals),
-      world->GetResource(Resource::Gas),
-      world->GetResource(Resource::Science)
+      Rect(Point(504, 12), Point(40, 96)),
+      fmt::format(
+        "{}\n{}\n{}\n{}\n{}\n{}",
+        shownValues[0],
+        shownValues[1],
+        shownValues[2],
+        shownValues[3],
+        shownValues[4],
+        shownValues[5]
+      )
     );
 
-    font.drawBox(
-      render.Get(),
-      Rect(lc.t(Point(12, 12)), Point(400, 96)),
-      "%s",
-      world->GetStatus().c_str()
-    );
+    font->drawBox(render.Get(), Rect(Point(12, 12), Point(400, 96)), world->GetStatus());
 
     std::string fullLog;
     for(const auto& logItem : world->GetLog()) {
       fullLog.append(logItem);
       fullLog.append("\n");
     }
-    font.drawBox(render.Get(), Rect(lc.t(Point(12, 40)), Point(400, 176)), "%s", fullLog.c_str());
+    font->drawBox(render.Get(), Rect(Point(12, 40), Point(400, 176)), fullLog);
+  }
+public:
+  ResourceUI(World *world) : Presenter("ResourceUI"), world(world) {
+  }
+
+  bool IsDirty() override {
+    return world->GetVersion() != renderedVersion || GetBlendedValues() != shownValues;
+  }
+
+  bool IsAnimating() override {
+    for(size_t i = 0; i < shownResources.size(); i++) {
+      if(shownValues[i] != world->GetResource(shownResources[i])) return true;
+    }
+    return false;
+  }
+
+  void Render() override {
+    renderedVersion = world->GetVersion();
+
+    auto values = GetBlendedValues();
+    if(values != shownValues) {
+      shownValues = values;
+      panel.Invalidate();
+    }
 
-    render.SetDrawColor(oldDrawColor);
+    if(panel.IsStale(world->GetVersion())) {
+      PROFILE_ZONE("ResourceUI::RenderPanel");
+
+      panel.Begin();
+      RenderPanel();
+      panel.End(world->GetVersion());
+    }
+    panel.Blit(commands, CommandBuffer::PANEL_LAYER);
   }
 };
 
 class FoundationUI : Presenter {
 private:
   SDL2pp::Renderer &render = Game::Instance()->GetRender();
-  SDL2pp::Texture ground = SDL2pp::Texture(render, "./assets/isometric.png");
+  std::shared_ptr<SDL2pp::Texture> ground = Game::Instance()->GetAssets().GetTexture("./assets/isometric.png");
+  SpriteBatch batch = SpriteBatch(render);
 
   World *world;
+  Camera *camera;
+  SpriteLayer *sprites;
+  std::vector<int> tileSprites;
+  std::vector<Tile::Type> syncedTiles;
+  unsigned int syncedFoundation = 0;
+
+  struct Collapse {
+    int sprite;
+    Rect rect;
+    int depth;
+    int tick;
+    float start;
+  };
+  std::vector<Collapse> collapses;
+  unsigned int renderedVersion = 0;
+  unsigned int renderedCamera = 0;
+  unsigned int renderedSprites = 0;
+  bool panning = false;
+
+  RenderCache layer;
+  unsigned int layerCamera = 0;
+
+  void SyncTiles() {
+    auto &tiles = world->GetFoundation();
+    int size = World::GetSize();
+
+    for(int row = 0; row < size; row++) {
+      for(int col = 0; col < size; col++) {
+        int index = row * size + col;
+        if(tiles[row][col] == Tile::Type::Null && syncedTiles[index] != Tile::Type::Null) {
+          StartCollapse(row, col, syncedTiles[index]);
+        }
+
+        syncedTiles[index] = tiles[row][col];
+        sprites->SetSource(tileSprites[index], world->GetTile(tiles[row][col]));
+      }
+    }
+    syncedFoundation = world->GetFoundationVersion();
+  }
+
+  void StartCollapse(int row, int col, Tile::Type type) {
+    Rect rect = SpriteLayer::GetTileRect(row, col);
+    int depth = SpriteLayer::GetTileDepth(row, col);
+    int id = sprites->Add(*ground, world->GetTile(type), rect, depth);
+
+    collapses.push_back(Collapse{id, rect, depth, world->GetTick(), world->GetInterpolation()});
+  }
+
+  void UpdateCollapses() {
+    float alpha = world->GetInterpolation();
+
+    // A removed tile falls away until the next simulation tick
+    for(auto it = std::begin(collapses); it != std::end(collapses);) {
+      float progress = 1.0f;
+      if(it->tick == world->GetTick() && it->start < 1.0f) {
+        progress = (alpha - it->start) / (1.0f - it->start);
+      }
+
+      if(progress >= 1.0f) {
+        sprites->Remove(it->sprite);
+        it = collapses.erase(it);
+        continue;
+      }
+
+      Rect rect = it->rect;
+      rect.y += static_cast<int>(progress * progress * 96);
+      sprites->Move(it->sprite, rect, it->depth);
+      ++it;
+    }
+  }
+public:
+  FoundationUI(World *world, Camera *camera, SpriteLayer *sprites) :
+    Presenter("FoundationUI"),
+    world(world),
+    camera(camera),
+    sprites(sprites),
+    layer(render, camera->GetViewport())
+  {
+    auto &tiles = world->GetFoundation();
+    int size = World::GetSize();
+
+    for(int row = 0; row < size; row++) {
+      for(int col = 0; col < size; col++) {
+        tileSprites.push_back(sprites->Add(
+          *ground,
+          world->GetTile(tiles[row][col]),
+          SpriteLayer::GetTileRect(row, col),
+          SpriteLayer::GetTileDepth(row, col)
+        ));
+        syncedTiles.push_back(tiles[row][col]);
+      }
+    }
+    syncedFoundation = world->GetFoundationVersion();
+  }
+
+  ~FoundationUI() {
+    for(int id : tileSprites) {
+      sprites->Remove(id);
+    }
+
+    for(const auto& collapse : collapses) {
+      sprites->Remove(collapse.sprite);
+    }
+  }
+
+  void Interact(Input *input) override {
+    auto *mouse = input->Mouse();
+    Point mousePosition = mouse->GetPosition();
+    bool hovered = camera->GetViewport().Contains(mousePosition);
+
+    if(mouse->ButtonTriggered(SDL_BUTTON_RIGHT) && hovered) {
+      panning = true;
+    } else if(!mouse->ButtonPressed(SDL_BUTTON_RIGHT)) {
+      panning = false;
+    }
+
+    if(panning) {
+      camera->Pan(mouse->GetDifference());
+    }
+
+    if(mouse->GetWheelY() != 0 && hovered) {
+      camera->Zoom(std::pow(1.1f, mouse->GetWheelY()), mousePosition);
+    }
+  }
+
+  bool IsDirty() override {
+    return world->GetVersion() != renderedVersion ||
+      camera->GetVersion() != renderedCamera ||
+      sprites->GetVersion() != renderedSprites ||
+      !collapses.empty();
+  }
+
+  bool IsAnimating() override {
+    return !collapses.empty();
+  }
+
+  void Render() override {
+    if(syncedFoundation != world->GetFoundationVersion()) {
+      SyncTiles();
+    }
+    UpdateCollapses();
+
+    renderedVersion = world->GetVersion();
+    renderedCamera = camera->GetVersion();
+    renderedSprites = sprites->GetVersion();
+
+    if(layerCamera != camera->GetVersion()) {
+      layerCamera = camera->GetVersion();
+      layer.Invalidate();
+    }
+
+    if(layer.IsStale(sprites->GetVersion())) {
+      PROFILE_ZONE("FoundationUI::RenderLayer");
+
+      layer.Begin();
+      sprites->Render(batch, *camera, camera->GetViewport().GetTopLeft());
+      layer.End(sprites->GetVersion());
+    }
+    layer.Blit(Game::Instance()->GetCommands(), CommandBuffer::MAP_LAYER);
+  }
+};
+
+class ProfilerUI : Presenter {
+private:
+  SDL2pp::Renderer &render = Game::Instance()->GetRender();
+  std::shared_ptr<NFont> font = Game::Instance()->GetAssets().GetFont("./assets/Fontana.ttf", 12);
+  CommandBuffer &commands = Game::Instance()->GetCommands();
+
+  bool visible;
+  bool toggled = false;
+  int traceFrames;
+  std::string tracePath;
+
+  // Game draws the frame after every presenter has recorded, so the text is copied in
+  void DrawText(int layer, const Rect &box, const std::string &text) {
+    commands.Custom(layer, [this, box, text] {
+      PROFILE_ZONE("NFont::drawBox");
+      font->drawBox(render.Get(), box, text);
+    });
+  }
 public:
-  FoundationUI(World *world) : world(world) {
+  ProfilerUI(bool visible, int traceFrames, const std::string &tracePath) :
+    Presenter("ProfilerUI"),
+    visible(visible),
+    traceFrames(traceFrames),
+    tracePath(tracePath)
+  {
+    if(visible) Profiler::Instance()->SetEnabled(true);
+  }
+
+  void Interact(Input *input) override {
+    if(input->Keyboard()->KeyTriggered(SDL_SCANCODE_F3)) {
+      visible = !visible;
+      toggled = true;
+      Profiler::Instance()->SetEnabled(visible || Profiler::Instance()->IsCapturing());
+    }
+
+    if(input->Keyboard()->KeyTriggered(SDL_SCANCODE_F4) && !Profiler::Instance()->IsCapturing()) {
+      Profiler::Instance()->CaptureFrames(traceFrames, tracePath);
+    }
+  }
+
+  bool IsDirty() override {
+    return visible || toggled;
+  }
+
+  bool IsAnimating() override {
+    return visible || Profiler::Instance()->IsCapturing();
   }
 
   void Render() override {
-    auto &tiles = world->GetFoundation();
-    for(const auto& tileRow : tiles) {
-      auto rowIndex = &tileRow - &tiles[0];
-      for(const auto& tile : tileRow) {
-        auto colIndex = &tile - &tileRow[0];
+    toggled = false;
+    if(!visible) return;
+
+    LocalCoordinates lc([] (Point point) {
+      return point + Point(560, 8);
+    });
+
+    std::string names = "Zone, ms\n";
+    std::string columns[5] = {"avg\n", "p50\n", "p95\n", "p99\n", "max\n"};
+    auto summary = Profiler::Instance()->GetSummary();
+    for(const auto& zone : summary) {
+      names.append(fmt::format("{:{}}{}\n", "", zone.depth * 2, zone.name));
+      columns[0].append(fmt::format("{:.2f}\n", zone.average));
+      columns[1].append(fmt::format("{:.2f}\n", zone.p50));
+      columns[2].append(fmt::format("{:.2f}\n", zone.p95));
+      columns[3].append(fmt::format("{:.2f}\n", zone.p99));
+      columns[4].append(fmt::format("{:.2f}\n", zone.max));
+    }
+
+    int lineHeight = font->getHeight();
+    int height = 16 + (summary.size() + 1) * lineHeight;
+    int latencyTop = height + 8;
+    int latencyHeight = 16 + (LatencyHistogram::BUCKETS + 2) * lineHeight;
+
+    const int layer = CommandBuffer::OVERLAY_LAYER;
+    commands.DrawRect(layer, Rect(lc.t(Point(0, 0)), Point(432, height + 8 + latencyHeight)), Color(0, 0, 0));
+    commands.FillRect(layer, Rect(lc.t(Point(1, 1)), Point(430, height + 6 + latencyHeight)), Color(224, 224, 224));
+
+    DrawText(layer + 1, Rect(lc.t(Point(8, 8)), Point(216, height - 16)), names);
+    for(int i = 0; i < 5; i++) {
+      DrawText(layer + 1, Rect(lc.t(Point(224 + i * 40, 8)), Point(40, height - 16)), columns[i]);
+    }
+
+    const auto &latency = Game::Instance()->GetLatency().GetEndToEnd();
+    DrawText(
+      layer + 1,
+      Rect(lc.t(Point(8, latencyTop)), Point(416, lineHeight)),
+      fmt::format(
+        "Input to present: {} samples, avg {:.1f} ms, p95 ~{:.1f} ms, max {:.1f} ms",
+        latency.GetTotal(),
+        latency.GetAverage(),
+        latency.GetPercentile(0.95f),
+        latency.GetMax()
+      )
+    );
+
+    unsigned int maxCount = 1;
+    for(int bucket = 0; bucket < LatencyHistogram::BUCKETS; bucket++) {
+      maxCount = std::max(maxCount, latency.GetCount(bucket));
+    }
+
+    for(int bucket = 0; bucket < LatencyHistogram::BUCKETS; bucket++) {
+      int y = latencyTop + (bucket + 1) * lineHeight;
+      float limit = LatencyHistogram::GetBucketLimit(bucket);
+      DrawText(layer + 1, Rect(lc.t(Point(8, y)), Point(64, lineHeight)), limit > 0 ? fmt::format("<= {} ms", limit) : "more");
+
+      int width = 344 * latency.GetCount(bucket) / maxCount;
+      commands.FillRect(layer + 1, Rect(lc.t(Point(80, y + 2)), Point(width, lineHeight - 4)), Color(140, 62, 173));
+    }
+
+    const auto &unsorted = CommandBuffer::GetUnsortedStats();
+    const auto &sorted = CommandBuffer::GetSortedStats();
+    DrawText(
+      layer + 1,
+      Rect(lc.t(Point(8, latencyTop + (LatencyHistogram::BUCKETS + 1) * lineHeight)), Point(416, lineHeight)),
+      fmt::format(
+        "Commands: {}, draw calls {} -> {}, state changes {} -> {}",
+        sorted.commands,
+        unsorted.drawCalls,
+        sorted.drawCalls,
+        unsorted.stateChanges,
+        sorted.stateChanges
+      )
+    );
+  }
+};
+
+struct Options {
+  bool profile = false;
+  bool retained = false;
+  bool idle = true;
+  bool trace = false;
+  int traceFrames = 300;
+  std::string tracePath = "trace.json";
+  unsigned int seed = time(nullptr);
+  std::string recordPath;
+  std::string playPath;
+  std::string latencyPath;
+  bool assetReport = false;
+  std::string goldenPath;
+  bool goldenUpdate = false;
+  int goldenTolerance = 2;
+  int benchFrames = 0;
+  int benchGlyphs = 0;
+  std::string capturePath;
+  int captureEvery = 1;
+  bool captureRaw = false;
+
+  Options(int argc, char *argv[]) {
+    for(int i = 1; i < argc; i++) {
+      std::string arg = argv[i];
+      bool hasValue = i + 1 < argc;
 
-        SDL2pp::Point tilePoint = SDL2pp::Point(642, 64) + LocalCoordinates::Isometric(SDL2pp::Point(rowIndex * 32, colIndex * 32));
-        render.Copy(ground, world->GetTile(tile), SDL2pp::Rect(tilePoint, SDL2pp::Point(64, 64)));
+      if(arg == "--profile") {
+        profile = true;
+      } else if(arg == "--no-idle") {
+        idle = false;
+      } else if(arg == "--retained") {
+        retained = true;
+      } else if(arg == "--trace") {
+        trace = true;
+      } else if(arg == "--trace-frames" && hasValue) {
+        traceFrames = std::atoi(argv[++i]);
+      } else if(arg == "--trace-file" && hasValue) {
+        tracePath = argv[++i];
+      } else if(arg == "--seed" && hasValue) {
+        seed = std::strtoul(argv[++i], nullptr, 10);
+      } else if(arg == "--record" && hasValue) {
+        recordPath = argv[++i];
+      } else if(arg == "--play" && hasValue) {
+        playPath = argv[++i];
+      } else if(arg == "--latency-report" && hasValue) {
+        latencyPath = argv[++i];
+      } else if(arg == "--asset-report") {
+        assetReport = true;
+      } else if(arg == "--golden" && hasValue) {
+        goldenPath = argv[++i];
+      } else if(arg == "--golden-update") {
+        goldenUpdate = true;
+      } else if(arg == "--golden-tolerance" && hasValue) {
+        goldenTolerance = std::atoi(argv[++i]);
+      } else if(arg == "--bench-render" && hasValue) {
+        benchFrames = std::atoi(argv[++i]);
+      } else if(arg == "--bench-glyphs" && hasValue) {
+        benchGlyphs = std::atoi(argv[++i]);
+      } else if(arg == "--capture" && hasValue) {
+        capturePath = argv[++i];
+      } else if(arg == "--capture-every" && hasValue) {
+        captureEvery = std::atoi(argv[++i]);
+      } else if(arg == "--capture-raw") {
+        captureRaw = true;
+      } else {
+        std::cerr << "Unknown option: " << arg << std::endl;
       }
     }
   }
 };
 
+struct Stage {
+  World world;
+  Camera camera;
+  SpriteLayer sprites;
+  Picker picker;
+  FoundationUI fui;
+  ResourceUI rui;
+  BuildUI bui;
+  ModalUI mui;
+
+  Stage(unsigned int seed) :
+    world(seed),
+    camera(Rect(368, 0, 632, 384), Point(642, 64)),
+    picker(&world, &camera, "./assets/isometric.png"),
+    fui(&world, &camera, &sprites),
+    rui(&world),
+    bui(&world, &picker, &sprites),
+    mui(&world)
+  {
+  }
+};
+
+struct GoldenScene {
+  std::string name;
+  std::function<void(Stage&)> setup;
+};
+
+static const unsigned int GOLDEN_SEED = 42;
+
+std::vector<GoldenScene> GetGoldenScenes() {
+  return {
+    {"start", [](Stage &stage) {}},
+    {"built", [](Stage &stage) {
+      auto &tiles = stage.world.GetFoundation();
+      for(int x = 0; x < World::GetSize(); x++) {
+        for(int y = 0; y < World::GetSize(); y++) {
+          if(tiles[x][y] == Tile::Type::Ground) {
+            stage.world.TryToBuild(Building::Type::OxygenTank, x, y);
+            return;
+          }
+        }
+      }
+    }},
+    {"collapsed", [](Stage &stage) {
+      stage.world.RemoveTile(12);
+    }},
+    {"zoomed", [](Stage &stage) {
+      stage.camera.Zoom(2.0f, Point(642, 200));
+      stage.camera.Pan(Point(-40, 24));
+    }},
+  };
+}
+
+int RunGolden(const Options &options) {
+  auto *game = Game::Instance();
+  int failures = 0;
+
+  for(const auto& scene : GetGoldenScenes()) {
+    Stage stage(GOLDEN_SEED);
+    scene.setup(stage);
+    game->Redraw();
+
+    SDL_Surface *frame = game->GetCanvas()->Get();
+    std::string path = fmt::format("{}/{}.png", options.goldenPath, scene.name);
+
+    if(options.goldenUpdate) {
+      if(!Golden::Save(frame, path)) {
+        std::cerr << "Error: unable to write " << path << std::endl;
+        return 1;
+      }
+      std::cout << "Golden: wrote " << path << std::endl;
+      continue;
+    }
+
+    Golden::Difference difference;
+    bool comparable = Golden::Compare(frame, path, options.goldenTolerance, difference);
+    if(comparable && difference.pixels == 0) {
+      std::cout << fmt::format("Golden: {} passed, max delta {}", scene.name, difference.maxDelta) << std::endl;
+      continue;
+    }
+
+    failures++;
+    std::string actualPath = fmt::format("{}/{}.actual.png", options.goldenPath, scene.name);
+    Golden::Save(frame, actualPath);
+    if(comparable) {
+      std::cout << fmt::format(
+        "Golden: {} FAILED, {} pixels over tolerance {}, max delta {}, see {}",
+        scene.name,
+        difference.pixels,
+        options.goldenTolerance,
+        difference.maxDelta,
+        actualPath
+      ) << std::endl;
+    } else {
+      std::cout << fmt::format("Golden: {} FAILED, {} is missing or has another size, see {}", scene.name, path, actualPath) << std::endl;
+    }
+  }
+
+  return failures == 0 ? 0 : 1;
+}
+
+int RunRenderBenchmark(int frames) {
+  auto *game = Game::Instance();
+  Stage stage(GOLDEN_SEED);
+
+  // The first frame fills glyph caches and the foundation layer
+  game->Redraw();
+
+  Uint64 startTime = SDL_GetPerformanceCounter();
+  for(int i = 0; i < frames; i++) {
+    game->Redraw();
+  }
+  double seconds = static_cast<double>(SDL_GetPerformanceCounter() - startTime) / SDL_GetPerformanceFrequency();
+
+  std::cout << fmt::format(
+    "Render benchmark: {} frames in {:.2f} s ({:.1f} fps, {:.3f} ms per frame)",
+    frames,
+    seconds,
+    frames / seconds,
+    seconds * 1000.0 / frames
+  ) << std::endl;
+
+  const auto &unsorted = CommandBuffer::GetUnsortedStats();
+  const auto &sorted = CommandBuffer::GetSortedStats();
+  std::cout << fmt::format(
+    "Commands per frame: {}, draw calls {} -> {}, state changes {} -> {}",
+    sorted.commands,
+    unsorted.drawCalls,
+    sorted.drawCalls,
+    unsorted.stateChanges,
+    sorted.stateChanges
+  ) << std::endl;
+
+  return 0;
+}
+
+int RunGlyphBenchmark(int lookups) {
+  auto *game = Game::Instance();
+
+  FC_Font *font = FC_CreateFont();
+  if(!FC_LoadFont(font, game->GetRender().Get(), "./assets/Fontana.ttf", 14, FC_MakeColor(0, 0, 0, 255), 0)) {
+    std::cerr << "Error: unable to load ./assets/Fontana.ttf" << std::endl;
+    FC_FreeFont(font);
+    return 1;
+  }
+
+  // Mostly ASCII like the UI text, plus a few codepoints that go through the hashed table
+  const Uint32 codepoints[] = {'A', 's', 't', 'e', 'r', 'o', 'i', 'd', ' ', '7', ':', ',', 0xE9, 0xFC, 0x416, 0x3A9};
+  const int count = sizeof(codepoints) / sizeof(codepoints[0]);
+
+  // Renders the glyphs missing from the loading string before timing
+  FC_GlyphData glyph;
+  for(int i = 0; i < count; i++) {
+    FC_GetGlyphData(font, &glyph, codepoints[i]);
+  }
+
+  unsigned int checksum = 0;
+  Uint64 startTime = SDL_GetPerformanceCounter();
+  for(int i = 0; i < lookups; i++) {
+    if(FC_GetGlyphData(font, &glyph, codepoints[i % count])) checksum += glyph.rect.w;
+  }
+  double lookupSeconds = static_cast<double>(SDL_GetPerformanceCounter() - startTime) / SDL_GetPerformanceFrequency();
+
+  // Every event text and choice the modal can show
+  World world{World::Catalog{}};
+  std::vector<std::string> texts;
+  size_t length = 0;
+  for(const auto& info : world.GetEventInfos()) {
+    for(const auto& step : info.second->steps) {
+      texts.push_back(step.second.text);
+      for(const auto& choice : step.second.choices) texts.push_back(choice.second);
+    }
+  }
+  for(const auto& text : texts) length += text.size();
+
+  // Each measure walks all of the texts, so the work roughly matches the lookups
+  int measures = std::max<int>(1, lookups / std::max<size_t>(1, length));
+  auto measure = [&](FC_MeasureEnum mode, unsigned int *sum) {
+    *sum = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for(int i = 0; i < measures; i++) {
+      for(const auto& text : texts) *sum += FC_GetTextWidthMeasure(font, mode, text.c_str());
+    }
+    return static_cast<double>(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+  };
+
+  unsigned int glyphSum, tableSum;
+  double glyphSeconds = measure(FC_MEASURE_GLYPHS, &glyphSum);
+  double tableSeconds = measure(FC_MEASURE_TABLE, &tableSum);
+
+  std::cout << fmt::format(
+    "Glyph benchmark: {} lookups in {:.3f} s ({:.1f} M lookups/s), checksum {}",
+    lookups,
+    lookupSeconds,
+    lookups / lookupSeconds / 1e6,
+    checksum
+  ) << std::endl;
+  std::cout << fmt::format(
+    "Event text measure: {:.1f} MB glyph by glyph in {:.3f} s ({:.1f} MB/s), width table ({}) in {:.3f} s ({:.1f} MB/s), {:.2f}x",
+    measures * length / 1e6,
+    glyphSeconds,
+    measures * length / glyphSeconds / 1e6,
+    FC_GetMeasureASCIIName(),
+    tableSeconds,
+    measures * length / tableSeconds / 1e6,
+    glyphSeconds / tableSeconds
+  ) << std::endl;
+
+  if(glyphSum != tableSum) {
+    std::cerr << fmt::format("Error: widths differ, {} glyph by glyph and {} from the table", glyphSum, tableSum) << std::endl;
+    FC_FreeFont(font);
+    return 1;
+  }
+
+  FC_FreeFont(font);
+  return 0;
+}
+
 #ifdef __EMSCRIPTEN__
 void emscriptenloop() {
   Game::Instance()->Step();
 }
 #endif
 
-int main() {
+int main(int argc, char *argv[]) {
   try {
+    Options options(argc, argv);
+    if(!options.goldenPath.empty() || options.benchFrames > 0 || options.benchGlyphs > 0) {
+      Game::SetHeadless(true);
+      if(!options.goldenPath.empty()) return RunGolden(options);
+      if(options.benchGlyphs > 0) return RunGlyphBenchmark(options.benchGlyphs);
+      return RunRenderBenchmark(options.benchFrames);
+    }
+
     auto *game = Game::Instance();
+    game->SetDamageTracking(options.retained);
+    game->SetIdleWait(options.idle);
 
-    World world;
-    FoundationUI fui(&world);
-    ResourceUI rui(&world);
-    BuildUI bui(&world);
-    ModalUI mui(&world);
+    Replay replay;
+    unsigned int seed = options.seed;
+    if(!options.playPath.empty()) {
+      if(!replay.StartPlayback(options.playPath)) {
+        std::cerr << "Error: unable to read replay " << options.playPath << std::endl;
+        return 1;
+      }
+      seed = replay.GetSeed();
+    } else if(!options.recordPath.empty()) {
+      replay.StartRecording(options.recordPath, seed);
+    }
+    game->SetReplay(&replay);
+
+    std::unique_ptr<FrameCapture> capture;
+    if(!options.capturePath.empty()) {
+      auto format = options.captureRaw ? FrameCapture::Format::Raw : FrameCapture::Format::Png;
+      capture.reset(new FrameCapture(options.capturePath, format, options.captureEvery));
+      game->SetCapture(capture.get());
+    }
+
+    Stage stage(seed);
+    ProfilerUI pui(options.profile, options.traceFrames, options.tracePath);
+
+    if(options.assetReport) {
+      for(const auto& usage : game->GetAssets().GetUsage()) {
+        std::cout << fmt::format("Asset: {} - {} KiB, {} handles", usage.key, usage.bytes / 1024, usage.handles) << std::endl;
+      }
+    }
+
+    if(options.trace) {
+      Profiler::Instance()->CaptureFrames(options.traceFrames, options.tracePath);
+    }
 
   #ifdef __EMSCRIPTEN__
     emscripten_set_main_loop(emscriptenloop, 0, 1);
   #else
-    return game->Loop();
+    Uint64 startTime = SDL_GetPerformanceCounter();
+    int result = game->Loop();
+    double seconds = static_cast<double>(SDL_GetPerformanceCounter() - startTime) / SDL_GetPerformanceFrequency();
+
+    if(capture) {
+      capture->Finish();
+      game->SetCapture(nullptr);
+      std::cout << fmt::format(
+        "Capture: {} frames written, {} dropped, {} failed to write, {}x{} RGBA",
+        capture->GetWritten(),
+        capture->GetDropped(),
+        capture->GetFailed(),
+        capture->GetSize().x,
+        capture->GetSize().y
+      ) << std::endl;
+    }
+
+    if(replay.IsRecording() && !replay.Save()) {
+      std::cerr << "Error: unable to write replay " << options.recordPath << std::endl;
+      return 1;
+    }
+
+    if(options.latencyPath == "-") {
+      std::cout << game->GetLatency().ToJson() << std::endl;
+    } else if(!options.latencyPath.empty()) {
+      std::ofstream(options.latencyPath) << game->GetLatency().ToJson() << std::endl;
+    }
+
+    if(replay.GetMode() != Replay::Mode::Null) {
+      std::cout << fmt::format(
+        "Replay: {} frames in {:.2f} s ({:.1f} fps), seed {}, world digest {:08x}",
+        replay.GetFrameCount(),
+        seconds,
+        replay.GetFrameCount() / seconds,
+        seed,
+        stage.world.GetDigest()
+      ) << std::endl;
+    }
+
+    return result;
   #endif
 
   } catch (SDL2pp::Exception& e) {
@@ -0,0 +1,17 @@
+#ifndef _CHECK_HPP_
+  #define _CHECK_HPP_
+
+#include <iostream>
+
+static int failures = 0;
+
+// Keeps going after a failed check, so one run reports every broken expectation
+#define CHECK(condition) \
+  do { \
+    if(!(condition)) { \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" << #condition << ") failed" << std::endl; \
+      failures++; \
+    } \
+  } while(0)
+
+#endif
@@ -0,0 +1,282 @@
+// Pulls in the font cache itself so the checks can reach its static helpers
+#include "SDL_FontCache.c"
+
+static int failures = 0;
+
+#define CHECK(condition) \
+  do { \
+    if(!(condition)) { \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      failures++; \
+    } \
+  } while(0)
+
+static FC_GlyphData Glyph(Uint16 w) {
+  return FC_MakeGlyphData(0, 0, 0, w, 10);
+}
+
+// Sized for the random texts below, which stay under 64 bytes
+#define TEXT_SIZE 128
+
+static const char *tokens[] = {"a", "b", "c", "de", "fgh", "ijk", " ", "  ", "\n", "\xc3\xa9", "x"};
+
+static int CompareKeys(const void *a, const void *b) {
+  Uint32 x = *(const Uint32 *)a, y = *(const Uint32 *)b;
+  return (x > y) - (x < y);
+}
+
+static void CheckMap(void) {
+  FC_Map *map = FC_MapCreate(FC_DEFAULT_MAP_CAPACITY);
+  const int wide = 3 * FC_DEFAULT_MAP_CAPACITY;
+  Uint32 keys[FC_MAP_ASCII_SIZE + 3 * FC_DEFAULT_MAP_CAPACITY];
+  int i;
+
+  CHECK(FC_MapFind(map, 'a') == NULL);
+  CHECK(FC_MapFind(map, 0x416) == NULL);
+  CHECK(map->ascii_widths['a'] == FC_MAP_NO_WIDTH);
+  CHECK(FC_MapInsert(map, FC_MAP_EMPTY_KEY, Glyph(1)) == NULL);
+
+  // ASCII glyphs live outside the table, so it fills to half before growing whatever else is in the map
+  for(i = 'a'; i <= 'z'; i++) FC_MapInsert(map, i, Glyph(i - 'a' + 1));
+  CHECK(map->count == 26 && map->hashed == 0);
+  for(i = 0; i < FC_DEFAULT_MAP_CAPACITY / 2; i++) FC_MapInsert(map, 0x400 + 37 * i, Glyph(i + 1));
+  CHECK(map->hashed == FC_DEFAULT_MAP_CAPACITY / 2);
+  CHECK(map->capacity == FC_DEFAULT_MAP_CAPACITY);
+
+  // Enough wide codepoints to grow the table past its starting size twice
+  for(; i < wide; i++) FC_MapInsert(map, 0x400 + 37 * i, Glyph(i + 1));
+  CHECK(map->count == 26 + wide && map->hashed == wide);
+  CHECK(map->capacity >= 2 * map->hashed && map->capacity < 4 * map->hashed);
+
+  for(i = 'a'; i <= 'z'; i++) {
+    CHECK(FC_MapFind(map, i) != NULL && FC_MapFind(map, i)->rect.w == i - 'a' + 1);
+    CHECK(map->ascii_widths[i] == i - 'a' + 1);
+  }
+  for(i = 0; i < wide; i++) {
+    FC_GlyphData *glyph = FC_MapFind(map, 0x400 + 37 * i);
+    CHECK(glyph != NULL && glyph->rect.w == i + 1);
+  }
+  CHECK(FC_MapFind(map, 'A') == NULL);
+  CHECK(FC_MapFind(map, 0x401) == NULL);
+
+  // Inserting again replaces the glyph without counting it twice
+  FC_MapInsert(map, 'q', Glyph(40));
+  FC_MapInsert(map, 0x400 + 37 * 5, Glyph(50));
+  CHECK(map->count == 26 + wide && map->hashed == wide);
+  CHECK(FC_MapFind(map, 'q')->rect.w == 40);
+  CHECK(map->ascii_widths['q'] == 40);
+  CHECK(FC_MapFind(map, 0x400 + 37 * 5)->rect.w == 50);
+
+  // Widths too big for the table leave it to the slow path
+  FC_MapInsert(map, 'w', Glyph(0x8000));
+  CHECK(map->ascii_widths['w'] == FC_MAP_NO_WIDTH);
+  CHECK(FC_MapFind(map, 'w')->rect.w == 0x8000);
+
+  FC_MapGetKeys(map, keys);
+  for(i = 0; i < 26; i++) CHECK(keys[i] == (Uint32)('a' + i));
+  qsort(keys + 26, wide, sizeof(Uint32), CompareKeys);
+  for(i = 0; i < wide; i++) CHECK(keys[26 + i] == (Uint32)(0x400 + 37 * i));
+
+  FC_MapFree(map);
+}
+
+static FC_Font *TestFont(void) {
+  FC_Font *font = FC_CreateFont();
+  int i;
+
+  // Uneven widths so that where a line breaks depends on every glyph; 'x' is missing and measures as a space
+  for(i = 'a'; i <= 'k'; i++) FC_SetGlyphData(font, i, Glyph(i % 7 + 3));
+  FC_SetGlyphData(font, ' ', Glyph(4));
+  FC_SetGlyphData(font, 0xC3A9, Glyph(9));  // The cache keys glyphs by their UTF-8 bytes
+  return font;
+}
+
+static void RandomText(char *text) {
+  int count = rand() % 20;
+  text[0] = '\0';
+  while(count-- > 0) strcat(text, tokens[rand() % (sizeof(tokens) / sizeof(tokens[0]))]);
+}
+
+// The column fit FC_BreakLines replaced: split on newlines, then grow each line a word at a time and measure it whole
+static int OldFitToColumn(FC_Font *font, const char *text, int width, Uint8 keep_newlines, char lines[][TEXT_SIZE]) {
+  int num_lines = 0;
+  const char *start = text;
+
+  while(1) {
+    const char *end = start + strcspn(start, "\n");
+    const char *from = (keep_newlines && start != text ? start - 1 : start);
+    char piece[TEXT_SIZE];
+
+    snprintf(piece, TEXT_SIZE, "%.*s", (int)(end - from), from);
+    if(width > 0 && FC_GetTextWidth(font, piece) > width) {
+      char line[TEXT_SIZE], longer[TEXT_SIZE];
+      const char *word = piece;
+      size_t length = strcspn(word, " ");
+
+      snprintf(line, TEXT_SIZE, "%.*s ", (int)length, word);
+      while(word[length] == ' ') {
+        word += length + 1;
+        length = strcspn(word, " ");
+        snprintf(longer, TEXT_SIZE, "%s%.*s", line, (int)length, word);
+        if(FC_GetTextWidth(font, longer) > width) {
+          strcpy(lines[num_lines++], line);
+          snprintf(line, TEXT_SIZE, "%.*s ", (int)length, word);
+        } else {
+          strcat(longer, " ");
+          strcpy(line, longer);
+        }
+      }
+      strcpy(lines[num_lines++], line);
+    } else {
+      strcpy(lines[num_lines++], piece);
+    }
+
+    if(*end == '\0') return num_lines;
+    start = end + 1;
+  }
+}
+
+static void CheckBreakLines(void) {
+  FC_Font *font = TestFont();
+  char text[TEXT_SIZE], expected[TEXT_SIZE][TEXT_SIZE], actual[TEXT_SIZE];
+  int round, i;
+
+  srand(1);
+  for(round = 0; round < 20000; round++) {
+    int width = rand() % 80 - 5;
+    Uint8 keep_newlines = rand() % 2;
+    int num_expected, num_lines;
+    FC_LineBreak *lines;
+
+    RandomText(text);
+    num_expected = OldFitToColumn(font, text, width, keep_newlines, expected);
+    lines = FC_BreakLines(font, text, width, keep_newlines, &num_lines);
+    CHECK(num_lines == num_expected);
+    for(i = 0; i < num_lines && i < num_expected; i++) {
+      snprintf(actual, TEXT_SIZE, "%.*s%s", lines[i].length, text + lines[i].start, lines[i].space ? " " : "");
+      CHECK(strcmp(actual, expected[i]) == 0);
+    }
+  }
+
+  FC_FreeFont(font);
+}
+
+// Long runs of plain ASCII so the vector measurers get whole blocks, now and then broken by a newline,
+// a multi-byte glyph or the missing 'x'
+static void RandomRun(char *text) {
+  static const char letters[] = "abcdefghijk abcdefghijk abcdefghijk abcdefghijk\nx";
+  int length = rand() % (TEXT_SIZE - 2), i;
+
+  for(i = 0; i < length; i++) {
+    if(rand() % 64 == 0 && i + 2 <= length) {
+      text[i++] = '\xc3';
+      text[i] = '\xa9';
+    } else {
+      text[i] = letters[rand() % 48 == 0 ? 48 + rand() % 2 : rand() % 47];
+    }
+  }
+  text[i] = '\0';
+}
+
+// The width table has to give what adding up the glyphs one at a time does, whichever measurer reads it
+static void CheckWidths(void) {
+  const int num_measurers = sizeof(fc_ascii_measurers) / sizeof(fc_ascii_measurers[0]);
+  const FC_ASCIIMeasurer *selected;
+  char text[TEXT_SIZE];
+  int round, m;
+
+  FC_GetMeasureASCIIName();
+  selected = fc_ascii_measurer;
+  for(m = 0; m < num_measurers; m++) {
+    FC_Font *font;
+    if(fc_ascii_measurers[m].supported != NULL && !fc_ascii_measurers[m].supported()) {
+      printf("Skipping the %s measurer, this CPU can't run it\n", fc_ascii_measurers[m].name);
+      continue;
+    }
+
+    fc_ascii_measurer = &fc_ascii_measurers[m];
+    font = TestFont();
+    srand(2);
+    for(round = 0; round < 20000; round++) {
+      // Replaced glyphs have to reach the table too
+      if(round == 10000) FC_SetGlyphData(font, 'c', Glyph(20));
+
+      if(round % 2) RandomText(text);
+      else RandomRun(text);
+      CHECK(FC_GetTextWidthMeasure(font, FC_MEASURE_TABLE, text) == FC_GetTextWidthMeasure(font, FC_MEASURE_GLYPHS, text));
+
+      // The run itself, before the span width folds it into 16 bits
+      {
+        const Uint16 *widths = font->glyphs->ascii_widths;
+        Uint32 expected = 0, actual = 0;
+        int length = strlen(text);
+        CHECK(fc_ascii_measurer->measure(widths, text, length, &actual) == FC_MeasureASCII_Scalar(widths, text, length, &expected));
+        CHECK(actual == expected);
+      }
+    }
+
+    CHECK(FC_GetTextWidthMeasure(font, FC_MEASURE_TABLE, "ab\nx\xc3\xa9") == 13);
+    CHECK(FC_GetTextWidthMeasure(font, FC_MEASURE_TABLE, "abcdefghijkabcdefghijkabcdefghijkabcdefghijkabcdefghijk") == 5 * 79);  // 'c' is 20 wide by now
+    CHECK(FC_GetTextWidth(font, "") == 0);
+    FC_FreeFont(font);
+  }
+  fc_ascii_measurer = selected;
+}
+
+// Cached layouts have to place glyphs where drawing the wrapped lines one by one would
+static void CheckLayouts(void) {
+  FC_Font *font = TestFont();
+  char text[TEXT_SIZE];
+  int round, i, j;
+
+  FC_SetSpacing(font, 1);
+  srand(3);
+  for(round = 0; round < 2000; round++) {
+    int width = rand() % 80 + 1, num_lines;
+    FC_LineBreak *lines;
+    FC_Layout *layout;
+
+    RandomText(text);
+    layout = FC_GetLayout(font, text, width);
+    lines = FC_BreakLines(font, text, width, 0, &num_lines);
+    CHECK(layout->num_lines == num_lines);
+    CHECK(layout->height == num_lines * FC_GetLineHeight(font));
+    for(i = 0; i < num_lines && i < layout->num_lines; i++) {
+      const FC_LayoutLine *line = &layout->lines[i];
+      const FC_LayoutGlyph *glyph = layout->glyphs + line->first_glyph;
+      float x = 0;
+
+      CHECK(line->width == FC_GetLineBreakWidth(font, text, &lines[i]));
+      for(j = lines[i].start; j < lines[i].start + lines[i].length; j++) {
+        Uint16 w = (text[j] == '\xc3' ? 9 : text[j] >= 'a' && text[j] <= 'k' ? text[j] % 7 + 3 : 4);
+        if(text[j] >= 'a' && text[j] <= 'k') {
+          CHECK(glyph < layout->glyphs + line->first_glyph + line->num_glyphs && glyph->x == x && glyph->data.rect.w == w);
+          glyph++;
+        } else if(text[j] == '\xc3') {
+          CHECK(glyph->x == x && glyph->data.rect.w == 9);
+          glyph++;
+          j++;
+        }
+        x += w + 1;
+      }
+      CHECK(glyph == layout->glyphs + line->first_glyph + line->num_glyphs);
+    }
+  }
+
+  // Lowering the budget evicts right away
+  CHECK(font->layout_cache_size > 1024);
+  FC_SetLayoutCacheBudget(font, 1024);
+  CHECK(font->layout_cache_size <= 1024);
+  FC_SetLayoutCacheBudget(font, 0);
+  CHECK(font->layout_cache_size == 0 && font->layouts == NULL && font->layout_index_count == 0);
+
+  FC_FreeFont(font);
+}
+
+int main(void) {
+  CheckMap();
+  CheckBreakLines();
+  CheckWidths();
+  CheckLayouts();
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+#include "Check.hpp"
+#include "Input.hpp"
+
+static InputEvent MakeEvent(InputEvent::Type type, Sint32 code, Sint32 x, Sint32 y) {
+  InputEvent event;
+  event.type = type;
+  event.code = code;
+  event.x = x;
+  event.y = y;
+  return event;
+}
+
+int main() {
+  // Consecutive motion collapses into its latest position
+  {
+    Input input;
+    for(int i = 0; i < 10; i++) input.PushEvent(MakeEvent(InputEvent::Type::Motion, 0, i, i));
+    input.Update();
+
+    CHECK(input.GetFrameEvents().size() == 1);
+    CHECK(input.Mouse()->GetPosition().x == 9);
+    CHECK(input.GetDroppedEvents() == 0);
+  }
+
+  // Far more presses than the queue holds, with motion in between: no press or release is lost, and order holds
+  {
+    Input input;
+    const int presses = 1000;
+    for(int i = 0; i < presses; i++) {
+      input.PushEvent(MakeEvent(InputEvent::Type::Motion, 0, i, 0));
+      input.PushEvent(MakeEvent(i % 2 == 0 ? InputEvent::Type::ButtonDown : InputEvent::Type::ButtonUp, SDL_BUTTON_LEFT, i, 0));
+    }
+    input.Update();
+
+    int buttons = 0, previous = -1;
+    bool ordered = true;
+    for(const auto& event : input.GetFrameEvents()) {
+      if(event.type == InputEvent::Type::Motion) continue;
+
+      ordered = ordered && event.x == previous + 1;
+      previous = event.x;
+      buttons++;
+    }
+
+    CHECK(buttons == presses);
+    CHECK(ordered);
+    CHECK(input.GetDroppedEvents() > 0);
+    CHECK(input.GetFrameEvents().size() + input.GetDroppedEvents() == 2 * presses);
+    CHECK(input.Mouse()->ButtonReleased(SDL_BUTTON_LEFT));
+  }
+
+  // Once the queue is drained, it wraps around without losing anything
+  {
+    Input input;
+    for(int frame = 0; frame < 5; frame++) {
+      for(int i = 0; i < 200; i++) input.PushEvent(MakeEvent(InputEvent::Type::KeyDown, SDL_SCANCODE_1, i, 0));
+      input.Update();
+      CHECK(input.GetFrameEvents().size() == 200);
+      CHECK(input.GetFrameEvents().back().x == 199);
+    }
+    CHECK(input.GetDroppedEvents() == 0);
+  }
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "Check.hpp"
+#include "Profiler.hpp"
+
+static std::string ReadFile(const std::string &path) {
+  std::ifstream in(path);
+  std::stringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+static size_t Count(const std::string &text, const std::string &needle) {
+  size_t count = 0;
+  for(size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + needle.size())) count++;
+  return count;
+}
+
+int main() {
+  auto *profiler = Profiler::Instance();
+  const std::string path = "ProfilerTest.json";
+
+  // Interned names have to outlive the string they were built from
+  const char *built;
+  {
+    std::string name = std::string("Built") + "::Zone";
+    built = Profiler::Intern(name);
+  }
+  CHECK(Profiler::Intern("Built::Zone") == built);
+
+  profiler->CaptureFrames(2, path);
+  profiler->EndFrame();
+  CHECK(Profiler::IsEnabled());
+
+  for(int i = 0; i < 2; i++) {
+    CHECK(profiler->IsCapturing());
+    {
+      ProfileZone outer("Outer");
+      { ProfileZone quoted("Say \"hi\""); }
+      { ProfileZone escaped("Back\\slash\nand\ttab"); }
+      { ProfileZone interned(built); }
+    }
+    profiler->EndFrame();
+  }
+  CHECK(!profiler->IsCapturing());
+
+  // Names are escaped, and every sample of both frames is a complete event
+  std::string trace = ReadFile(path);
+  CHECK(trace.compare(0, 39, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+  CHECK(trace.size() >= 3 && trace.compare(trace.size() - 3, 3, "]}\n") == 0);
+  CHECK(Count(trace, "\"ph\":\"X\"") == 8);
+  CHECK(Count(trace, "\"name\":\"Outer\"") == 2);
+  CHECK(Count(trace, "\"name\":\"Say \\\"hi\\\"\"") == 2);
+  CHECK(Count(trace, "\"name\":\"Back\\\\slash\\nand\\ttab\"") == 2);
+  CHECK(Count(trace, "\"name\":\"Built::Zone\"") == 2);
+  CHECK(trace.find('\t') == std::string::npos);
+
+  // The summary merges samples by name, one zone each
+  auto summary = profiler->GetSummary();
+  CHECK(summary.size() == 4);
+  for(const auto& zone : summary) {
+    CHECK(zone.name == "Outer" ? zone.depth == 0 : zone.depth == 1);
+  }
+
+  std::remove(path.c_str());
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+#include <cstdio>
+#include <string>
+
+#include "Check.hpp"
+#include "Input.hpp"
+#include "Replay.hpp"
+
+int main() {
+  const std::string path = "ReplayTest.replay";
+
+  std::vector<std::vector<InputEvent>> recorded(3);
+  recorded[0].push_back(InputEvent{InputEvent::Type::Motion, 10, 0, 120, -5});
+  recorded[0].push_back(InputEvent{InputEvent::Type::ButtonDown, 11, SDL_BUTTON_LEFT, 120, -5});
+  recorded[2].push_back(InputEvent{InputEvent::Type::ButtonUp, 40, SDL_BUTTON_LEFT, 64, 32});
+  recorded[2].push_back(InputEvent{InputEvent::Type::Wheel, 41, 0, 0, -3});
+  recorded[2].push_back(InputEvent{InputEvent::Type::KeyDown, 42, SDL_SCANCODE_ESCAPE, 0, 0});
+
+  Replay recorder;
+  recorder.StartRecording(path, 1234567u);
+  for(size_t i = 0; i < recorded.size(); i++) {
+    recorder.RecordFrame(16 + i, recorded[i]);
+  }
+  CHECK(recorder.Save());
+
+  Replay player;
+  CHECK(player.StartPlayback(path));
+  CHECK(player.IsPlaying());
+  CHECK(player.GetSeed() == 1234567u);
+  CHECK(player.GetFrameCount() == recorded.size());
+
+  // Every frame comes back with its elapsed time and exactly the recorded events
+  Input input;
+  for(size_t i = 0; i < recorded.size(); i++) {
+    Uint32 elapsed = 0;
+    CHECK(player.PlayFrame(&input, elapsed));
+    CHECK(elapsed == 16 + i);
+
+    input.Update();
+    const auto &events = input.GetFrameEvents();
+    CHECK(events.size() == recorded[i].size());
+    for(size_t j = 0; j < events.size() && j < recorded[i].size(); j++) {
+      CHECK(events[j].type == recorded[i][j].type);
+      CHECK(events[j].timestamp == recorded[i][j].timestamp);
+      CHECK(events[j].code == recorded[i][j].code);
+      CHECK(events[j].x == recorded[i][j].x);
+      CHECK(events[j].y == recorded[i][j].y);
+    }
+  }
+
+  Uint32 elapsed = 0;
+  CHECK(!player.PlayFrame(&input, elapsed));
+
+  // Anything that isn't a replay is refused
+  {
+    FILE *file = std::fopen(path.c_str(), "w");
+    std::fputs("seed 1\nframe 16\nbogus 1 2 3\n", file);
+    std::fclose(file);
+  }
+  Replay broken;
+  CHECK(!broken.StartPlayback(path));
+  CHECK(!broken.IsPlaying());
+  CHECK(!broken.StartPlayback("ReplayTest.missing"));
+
+  std::remove(path.c_str());
+  return failures == 0 ? 0 : 1;
+}